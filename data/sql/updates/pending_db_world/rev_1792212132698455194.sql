@@ -0,0 +1,8 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792212132698455194');
+
+DELETE FROM `command` WHERE `name` IN ('server perf', 'server perf on', 'server perf off', 'server perf reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server perf', 3, 'Syntax: .server perf\r\nShows the update profiler timings of the world and map update phases, the slowest maps and opcodes, the update packet compression and the database queue statistics.'),
+('server perf on', 3, 'Syntax: .server perf on\r\nEnables the update profiler.'),
+('server perf off', 3, 'Syntax: .server perf off\r\nDisables the update profiler.'),
+('server perf reset', 3, 'Syntax: .server perf reset\r\nResets the update profiler, opcode and database queue statistics.');
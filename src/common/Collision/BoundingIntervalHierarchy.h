@@ -18,6 +18,7 @@
 #include <cstring>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #define MAX_STACK_SIZE 64
@@ -101,9 +102,74 @@ public:
         delete[] dat.indices;
     }
     [[nodiscard]] uint32 primCount() const { return objects.size(); }
+    //! primitive stored at the given position of the leaf order
+    [[nodiscard]] uint32 getObject(uint32 position) const { return objects[position]; }
+
+    //! ranges (first position, count) of the leaf order covered by each non-empty leaf
+    void getLeaves(std::vector<std::pair<uint32, uint32>>& leaves) const
+    {
+        std::vector<uint32> stack(1, 0);
+        while (!stack.empty())
+        {
+            uint32 node = stack.back();
+            stack.pop_back();
+
+            uint32 tn = tree[node];
+            uint32 axis = (tn & (3 << 30)) >> 30;
+            bool BVH2 = tn & (1 << 29);
+            uint32 offset = tn & ~(7 << 29);
+            if (BVH2)
+            {
+                if (axis < 3)
+                    stack.push_back(offset);
+            }
+            else if (axis < 3)
+            {
+                stack.push_back(offset);
+                stack.push_back(offset + 3);
+            }
+            else if (tree[node + 1] > 0)
+                leaves.emplace_back(offset, tree[node + 1]);
+        }
+    }
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        auto intersectLeaf = [&](uint32 offset, uint32 count)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                bool hit = intersectCallback(r, objects[offset + i], maxDist, stopAtFirstHit);
+                if (stopAtFirstHit && hit)
+                    return true;
+            }
+
+            return false;
+        };
+
+        traverseRay(r, intersectLeaf, maxDist);
+    }
+
+    /*! Like intersectRay, but the callback tests whole leaves:
+        bool callback(const G3D::Ray& ray, uint32 firstPosition, uint32 count, float& maxDist, bool stopAtFirstHit)
+        Positions are in leaf order, see getObject and getLeaves. */
+    template<typename LeafCallback>
+    void intersectRayLeaves(const G3D::Ray& r, LeafCallback& leafCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        auto intersectLeaf = [&](uint32 offset, uint32 count)
+        {
+            bool hit = leafCallback(r, offset, count, maxDist, stopAtFirstHit);
+            return stopAtFirstHit && hit;
+        };
+
+        traverseRay(r, intersectLeaf, maxDist);
+    }
+
+private:
+    //! the leaf function returns true to stop the traversal
+    template<typename LeafFunc>
+    void traverseRay(const G3D::Ray& r, LeafFunc& intersectLeaf, float& maxDist) const
     {
         float intervalMin = -1.f;
         float intervalMax = -1.f;
@@ -204,13 +270,8 @@ public:
                     {
                         // leaf - test some objects
                         int n = tree[node + 1];
-                        while (n > 0)
-                        {
-                            bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirstHit);
-                            if (stopAtFirstHit && hit) return;
-                            --n;
-                            ++offset;
-                        }
+                        if (n > 0 && intersectLeaf(offset, n))
+                            return;
                         break;
                     }
                 }
@@ -245,6 +306,7 @@ public:
         }
     }
 
+public:
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& p, IsectCallback& intersectCallback) const
     {
@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _DYNAMIC_BVH_H
+#define _DYNAMIC_BVH_H
+
+#include "Define.h"
+#include <G3D/AABox.h>
+#include <G3D/BoundsTrait.h>
+#include <G3D/Ray.h>
+#include <G3D/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*! Bounding volume hierarchy that is kept balanced while objects are inserted, moved and removed.
+    Every change costs O(log n) and queries never rebuild anything, so the tree is always current.
+    Leaves store the object bounds grown by DYNAMIC_BVH_MARGIN so small moves do not touch the tree. */
+template<class T, class BoundsFunc = BoundsTrait<T>>
+class DynamicBVH
+{
+    static constexpr int32 NULL_NODE = -1;
+    static constexpr float DYNAMIC_BVH_MARGIN = 0.5f;
+    // the tree is AVL balanced, its height stays far below this even for millions of objects
+    static constexpr uint32 MAX_STACK_SIZE = 64;
+
+    struct Node
+    {
+        G3D::AABox bounds;
+        T const* object;
+        int32 parent;           // next free node while the node is unused
+        int32 child1;
+        int32 child2;
+        int32 height;           // 0 for leaves, -1 for unused nodes
+
+        [[nodiscard]] bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+public:
+    DynamicBVH() : _root(NULL_NODE), _freeList(NULL_NODE) { }
+
+    void insert(T const& obj)
+    {
+        if (_leaves.count(&obj))
+            return;
+
+        int32 leaf = allocateNode();
+        _nodes[leaf].bounds = getFatBounds(obj);
+        _nodes[leaf].object = &obj;
+        _nodes[leaf].height = 0;
+        insertLeaf(leaf);
+        _leaves[&obj] = leaf;
+    }
+
+    void remove(T const& obj)
+    {
+        auto itr = _leaves.find(&obj);
+        if (itr == _leaves.end())
+            return;
+
+        removeLeaf(itr->second);
+        freeNode(itr->second);
+        _leaves.erase(itr);
+    }
+
+    /// Refits the leaf of an object whose bounds changed, the tree is only touched if it left its grown bounds
+    void update(T const& obj)
+    {
+        auto itr = _leaves.find(&obj);
+        if (itr == _leaves.end())
+            return insert(obj);
+
+        G3D::AABox bounds;
+        BoundsFunc::getBounds(obj, bounds);
+        if (_nodes[itr->second].bounds.contains(bounds))
+            return;
+
+        removeLeaf(itr->second);
+        _nodes[itr->second].bounds = getFatBounds(obj);
+        insertLeaf(itr->second);
+    }
+
+    [[nodiscard]] bool contains(T const& obj) const { return _leaves.count(&obj) != 0; }
+    [[nodiscard]] uint32 size() const { return uint32(_leaves.size()); }
+    [[nodiscard]] int32 height() const { return _root != NULL_NODE ? _nodes[_root].height : 0; }
+
+    template<typename RayCallback>
+    void intersectRay(G3D::Ray const& ray, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        if (_root == NULL_NODE)
+            return;
+
+        float entry;
+        if (!intersectBounds(ray, _nodes[_root].bounds, maxDist, entry))
+            return;
+
+        std::array<std::pair<int32, float>, MAX_STACK_SIZE> stack;
+        uint32 stackSize = 0;
+        stack[stackSize++] = { _root, entry };
+
+        while (stackSize)
+        {
+            auto [index, nodeEntry] = stack[--stackSize];
+            // maxDist may have shrunk since the node was pushed
+            if (nodeEntry > maxDist)
+                continue;
+
+            Node const& node = _nodes[index];
+            if (node.isLeaf())
+            {
+                if (intersectCallback(ray, *node.object, maxDist, stopAtFirstHit) && stopAtFirstHit)
+                    return;
+                continue;
+            }
+
+            float entry1, entry2;
+            bool hit1 = intersectBounds(ray, _nodes[node.child1].bounds, maxDist, entry1);
+            bool hit2 = intersectBounds(ray, _nodes[node.child2].bounds, maxDist, entry2);
+
+            // the closer child is pushed last so it is tested first and can shorten maxDist for the other
+            if (hit1 && hit2 && entry1 < entry2)
+            {
+                stack[stackSize++] = { node.child2, entry2 };
+                stack[stackSize++] = { node.child1, entry1 };
+            }
+            else
+            {
+                if (hit1)
+                    stack[stackSize++] = { node.child1, entry1 };
+                if (hit2)
+                    stack[stackSize++] = { node.child2, entry2 };
+            }
+        }
+    }
+
+    template<typename IsectCallback>
+    void intersectPoint(G3D::Vector3 const& point, IsectCallback& intersectCallback) const
+    {
+        if (_root == NULL_NODE)
+            return;
+
+        std::array<int32, MAX_STACK_SIZE> stack;
+        uint32 stackSize = 0;
+        stack[stackSize++] = _root;
+
+        while (stackSize)
+        {
+            Node const& node = _nodes[stack[--stackSize]];
+            if (!node.bounds.contains(point))
+                continue;
+
+            if (node.isLeaf())
+                intersectCallback(point, *node.object);
+            else
+            {
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+    }
+
+private:
+    static G3D::AABox getFatBounds(T const& obj)
+    {
+        G3D::AABox bounds;
+        BoundsFunc::getBounds(obj, bounds);
+        G3D::Vector3 const margin(DYNAMIC_BVH_MARGIN, DYNAMIC_BVH_MARGIN, DYNAMIC_BVH_MARGIN);
+        return G3D::AABox(bounds.low() - margin, bounds.high() + margin);
+    }
+
+    static G3D::AABox combine(G3D::AABox const& left, G3D::AABox const& right)
+    {
+        G3D::AABox bounds(left);
+        bounds.merge(right);
+        return bounds;
+    }
+
+    /// Slab test against [0, maxDist], entry is the distance at which the ray enters the box
+    static bool intersectBounds(G3D::Ray const& ray, G3D::AABox const& bounds, float maxDist, float& entry)
+    {
+        float tNear = 0.0f;
+        float tFar = maxDist;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float origin = ray.origin()[axis];
+            float invDir = ray.invDirection()[axis];
+            float t1 = (bounds.low()[axis] - origin) * invDir;
+            float t2 = (bounds.high()[axis] - origin) * invDir;
+            if (t1 > t2)
+                std::swap(t1, t2);
+
+            // 0 * inf gives NaN for rays parallel to a box face, the comparisons then keep the interval
+            if (t1 > tNear)
+                tNear = t1;
+            if (t2 < tFar)
+                tFar = t2;
+            if (tNear > tFar)
+                return false;
+        }
+
+        entry = tNear;
+        return true;
+    }
+
+    int32 allocateNode()
+    {
+        if (_freeList == NULL_NODE)
+        {
+            _nodes.emplace_back();
+            _nodes.back().parent = NULL_NODE;
+            _freeList = int32(_nodes.size()) - 1;
+        }
+
+        int32 index = _freeList;
+        Node& node = _nodes[index];
+        _freeList = node.parent;
+        node.object = nullptr;
+        node.parent = NULL_NODE;
+        node.child1 = NULL_NODE;
+        node.child2 = NULL_NODE;
+        node.height = 0;
+        return index;
+    }
+
+    void freeNode(int32 index)
+    {
+        _nodes[index].object = nullptr;
+        _nodes[index].height = -1;
+        _nodes[index].parent = _freeList;
+        _freeList = index;
+    }
+
+    /// Attaches the leaf next to the sibling with the lowest surface area cost
+    void insertLeaf(int32 leaf)
+    {
+        if (_root == NULL_NODE)
+        {
+            _root = leaf;
+            _nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        G3D::AABox const bounds = _nodes[leaf].bounds;
+        int32 index = _root;
+        while (!_nodes[index].isLeaf())
+        {
+            Node const& node = _nodes[index];
+            float area = node.bounds.area();
+            float combinedArea = combine(node.bounds, bounds).area();
+
+            // cost of making a new parent for this node and the leaf
+            float cost = 2.0f * combinedArea;
+            // cost of pushing the leaf further down, every ancestor grows by it
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32 child)
+            {
+                Node const& childNode = _nodes[child];
+                float childArea = combine(bounds, childNode.bounds).area();
+                if (!childNode.isLeaf())
+                    childArea -= childNode.bounds.area();
+                return childArea + inheritanceCost;
+            };
+
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32 sibling = index;
+        int32 oldParent = _nodes[sibling].parent;
+        int32 newParent = allocateNode();
+        _nodes[newParent].parent = oldParent;
+        _nodes[newParent].bounds = combine(bounds, _nodes[sibling].bounds);
+        _nodes[newParent].height = _nodes[sibling].height + 1;
+        _nodes[newParent].child1 = sibling;
+        _nodes[newParent].child2 = leaf;
+        _nodes[sibling].parent = newParent;
+        _nodes[leaf].parent = newParent;
+
+        if (oldParent != NULL_NODE)
+        {
+            if (_nodes[oldParent].child1 == sibling)
+                _nodes[oldParent].child1 = newParent;
+            else
+                _nodes[oldParent].child2 = newParent;
+        }
+        else
+            _root = newParent;
+
+        refit(newParent);
+    }
+
+    void removeLeaf(int32 leaf)
+    {
+        if (leaf == _root)
+        {
+            _root = NULL_NODE;
+            return;
+        }
+
+        int32 parent = _nodes[leaf].parent;
+        int32 grandParent = _nodes[parent].parent;
+        int32 sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+        freeNode(parent);
+        _nodes[sibling].parent = grandParent;
+        _nodes[leaf].parent = NULL_NODE;
+
+        if (grandParent == NULL_NODE)
+        {
+            _root = sibling;
+            return;
+        }
+
+        if (_nodes[grandParent].child1 == parent)
+            _nodes[grandParent].child1 = sibling;
+        else
+            _nodes[grandParent].child2 = sibling;
+
+        refit(grandParent);
+    }
+
+    /// Rebalances and recomputes bounds and heights from index up to the root
+    void refit(int32 index)
+    {
+        while (index != NULL_NODE)
+        {
+            index = rotate(index);
+
+            Node& node = _nodes[index];
+            Node const& child1 = _nodes[node.child1];
+            Node const& child2 = _nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.bounds = combine(child1.bounds, child2.bounds);
+
+            index = node.parent;
+        }
+    }
+
+    /// Lifts the higher child of an unbalanced node into its place, returns the node now at that place
+    int32 rotate(int32 iA)
+    {
+        Node& A = _nodes[iA];
+        if (A.isLeaf() || A.height < 2)
+            return iA;
+
+        int32 iB = A.child1;
+        int32 iC = A.child2;
+        Node& B = _nodes[iB];
+        Node& C = _nodes[iC];
+
+        int32 balance = C.height - B.height;
+        if (balance > 1)
+            return rotateUp(iA, iC, B, false);
+        if (balance < -1)
+            return rotateUp(iA, iB, C, true);
+
+        return iA;
+    }
+
+    /// Moves child iUp of iA into the place of iA, iA keeps its other child and the lower grandchild
+    int32 rotateUp(int32 iA, int32 iUp, Node const& other, bool upIsChild1)
+    {
+        Node& A = _nodes[iA];
+        Node& up = _nodes[iUp];
+
+        int32 iF = up.child1;
+        int32 iG = up.child2;
+        Node& F = _nodes[iF];
+        Node& G = _nodes[iG];
+
+        up.child1 = iA;
+        up.parent = A.parent;
+        A.parent = iUp;
+
+        if (up.parent != NULL_NODE)
+        {
+            if (_nodes[up.parent].child1 == iA)
+                _nodes[up.parent].child1 = iUp;
+            else
+                _nodes[up.parent].child2 = iUp;
+        }
+        else
+            _root = iUp;
+
+        // the higher grandchild stays with the lifted node, the lower one goes down to A
+        int32 iHigh = F.height > G.height ? iF : iG;
+        int32 iLow = F.height > G.height ? iG : iF;
+        Node const& high = _nodes[iHigh];
+        Node& low = _nodes[iLow];
+
+        up.child2 = iHigh;
+        if (upIsChild1)
+            A.child1 = iLow;
+        else
+            A.child2 = iLow;
+        low.parent = iA;
+
+        A.bounds = combine(other.bounds, low.bounds);
+        A.height = 1 + std::max(other.height, low.height);
+        up.bounds = combine(A.bounds, high.bounds);
+        up.height = 1 + std::max(A.height, high.height);
+        return iUp;
+    }
+
+    std::vector<Node> _nodes;
+    std::unordered_map<T const*, int32> _leaves;
+    int32 _root;
+    int32 _freeList;
+};
+
+#endif // _DYNAMIC_BVH_H
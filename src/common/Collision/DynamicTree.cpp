@@ -5,23 +5,19 @@
  */
 
 #include "DynamicTree.h"
-#include "BoundingIntervalHierarchyWrapper.h"
+#include "DynamicBoundingVolumeHierarchy.h"
 #include "Log.h"
 #include "RegularGrid.h"
-#include "Timer.h"
 #include "GameObjectModel.h"
 #include "ModelInstance.h"
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
+#include <mutex>
+#include <shared_mutex>
 
 using VMAP::ModelInstance;
 
-namespace
-{
-    int CHECK_TREE_PERIOD = 200;
-}
-
 template<> struct HashTrait< GameObjectModel>
 {
     static size_t hashCode(const GameObjectModel& g) { return (size_t)(void*)&g; }
@@ -35,56 +31,15 @@ template<> struct PositionTrait< GameObjectModel>
 template<> struct BoundsTrait< GameObjectModel>
 {
     static void getBounds(const GameObjectModel& g, G3D::AABox& out) { out = g.getBounds();}
-    static void getBounds2(const GameObjectModel* g, G3D::AABox& out) { out = g->getBounds();}
 };
 
-typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel>> ParentTree;
+typedef RegularGrid2D<GameObjectModel, DynamicBVH<GameObjectModel>> ParentTree;
 
+// The cell trees are updated in place, so queries never rebuild anything and can run
+// concurrently from the threads updating the map; changes take the lock exclusively
 struct DynTreeImpl : public ParentTree
 {
-    typedef GameObjectModel Model;
-    typedef ParentTree base;
-
-    DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
-    {
-    }
-
-    void insert(const Model& mdl)
-    {
-        base::insert(mdl);
-        ++unbalanced_times;
-    }
-
-    void remove(const Model& mdl)
-    {
-        base::remove(mdl);
-        ++unbalanced_times;
-    }
-
-    void balance()
-    {
-        base::balance();
-        unbalanced_times = 0;
-    }
-
-    void update(uint32 difftime)
-    {
-        if (!size())
-            return;
-
-        rebalance_timer.Update(difftime);
-        if (rebalance_timer.Passed())
-        {
-            rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
-                balance();
-        }
-    }
-
-    TimeTrackerSmall rebalance_timer;
-    int unbalanced_times;
+    mutable std::shared_mutex lock;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
@@ -96,34 +51,40 @@ DynamicMapTree::~DynamicMapTree()
 
 void DynamicMapTree::insert(const GameObjectModel& mdl)
 {
+    std::unique_lock<std::shared_mutex> guard(impl->lock);
     impl->insert(mdl);
 }
 
 void DynamicMapTree::remove(const GameObjectModel& mdl)
 {
+    std::unique_lock<std::shared_mutex> guard(impl->lock);
     impl->remove(mdl);
 }
 
-bool DynamicMapTree::contains(const GameObjectModel& mdl) const
+bool DynamicMapTree::update(GameObjectModel& mdl)
 {
-    return impl->contains(mdl);
+    // queries read the bounds and transform of the model, they may only change under the exclusive lock
+    std::unique_lock<std::shared_mutex> guard(impl->lock);
+    if (!impl->contains(mdl))
+        return false;
+
+    mdl.UpdatePosition();
+    impl->update(mdl);
+    return true;
 }
 
-void DynamicMapTree::balance()
+bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 {
-    impl->balance();
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
+    return impl->contains(mdl);
 }
 
 int DynamicMapTree::size() const
 {
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
     return impl->size();
 }
 
-void DynamicMapTree::update(uint32 t_diff)
-{
-    impl->update(t_diff);
-}
-
 struct DynamicTreeIntersectionCallback
 {
     bool did_hit;
@@ -144,6 +105,7 @@ bool DynamicMapTree::getIntersectionTime(const uint32 phasemask, const G3D::Ray&
 {
     float distance = maxDist;
     DynamicTreeIntersectionCallback callback(phasemask);
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
     impl->intersectRay(ray, callback, distance, endPos, false);
     if (callback.didHit())
         maxDist = distance;
@@ -201,16 +163,38 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
 
     G3D::Ray r(v1, (v2 - v1) / maxDist);
     DynamicTreeIntersectionCallback callback(phasemask);
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
     impl->intersectRay(r, callback, maxDist, v2, true);
 
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, std::size_t count, uint32 phasemask) const
+{
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!results[i])
+            continue;
+
+        float maxDist = (ends[i] - starts[i]).magnitude();
+        if (!G3D::fuzzyGt(maxDist, 0))
+            continue;
+
+        G3D::Ray r(starts[i], (ends[i] - starts[i]) / maxDist);
+        DynamicTreeIntersectionCallback callback(phasemask);
+        impl->intersectRay(r, callback, maxDist, ends[i], true);
+        if (callback.did_hit)
+            results[i] = false;
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
     G3D::Ray r(v, G3D::Vector3(0, 0, -1));
     DynamicTreeIntersectionCallback callback(phasemask);
+    std::shared_lock<std::shared_mutex> guard(impl->lock);
     impl->intersectZAllignedRay(r, callback, maxSearchDist);
 
     if (callback.didHit())
@@ -8,6 +8,7 @@
 #define _DYNTREE_H
 
 #include "Define.h"
+#include <cstddef>
 
 namespace G3D
 {
@@ -28,6 +29,9 @@ public:
 
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
+    // results of blocked segments are set to false, segments already false are skipped
+    void isInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results,
+                         std::size_t count, uint32 phasemask) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
@@ -40,11 +44,10 @@ public:
 
     void insert(const GameObjectModel&);
     void remove(const GameObjectModel&);
+    // moves a contained model to the position of its owner, returns false if the model is not in the tree
+    bool update(GameObjectModel&);
     [[nodiscard]] bool contains(const GameObjectModel&) const;
     [[nodiscard]] int size() const;
-
-    void balance();
-    void update(uint32 diff);
 };
 
 #endif // _DYNTREE_H
@@ -162,10 +162,13 @@ namespace MMAP
 
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> tilesGuard(mmap->tilesLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            ++mmap->tileGeneration;
             ++loadedTiles;
             dtMeshHeader* header = (dtMeshHeader*)data;
             LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
@@ -209,6 +212,8 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> tilesGuard(mmap->tilesLock);
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
@@ -221,6 +226,7 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(packedGridPos);
+            ++mmap->tileGeneration;
             --loadedTiles;
             LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -262,70 +268,63 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
-
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
+            return nullptr;
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
+        return itr->second->navMesh;
+    }
 
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
+    uint32 MMapManager::GetNavMeshGeneration(uint32 mapId) const
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return 0;
 
-        return true;
+        return itr->second->tileGeneration.load(std::memory_order_relaxed);
     }
 
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
+    std::shared_lock<std::shared_mutex> MMapManager::LockTiles(uint32 mapId) const
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
-            return nullptr;
+            return std::shared_lock<std::shared_mutex>();
 
-        return itr->second->navMesh;
+        return std::shared_lock<std::shared_mutex>(itr->second->tilesLock);
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        std::thread::id threadId = std::this_thread::get_id();
         {
-            // check again after acquiring mutex
-            if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-            {
-                // allocate mesh query
-                dtNavMeshQuery* query = dtAllocNavMeshQuery();
-                ASSERT(query);
-
-                if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-                {
-                    dtFreeNavMeshQuery(query);
-                    LOG_ERROR("server", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                    return nullptr;
-                }
-
-                LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-            }
+            std::shared_lock<std::shared_mutex> guard(mmap->navMeshQueriesLock);
+            NavMeshQuerySet::const_iterator queryItr = mmap->navMeshQueries.find(threadId);
+            if (queryItr != mmap->navMeshQueries.end())
+                return queryItr->second;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        // allocate mesh query, only this thread can add a query for its own id
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            LOG_ERROR("server", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            return nullptr;
+        }
+
+        LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+
+        std::unique_lock<std::shared_mutex> guard(mmap->navMeshQueriesLock);
+        mmap->navMeshQueries.emplace(threadId, query);
+        return query;
     }
 }
@@ -11,8 +11,11 @@
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourExtended.h"
-#include <unordered_map>
+#include <atomic>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 //  memory management
@@ -30,12 +33,12 @@ inline void dtCustomFree(void* ptr)
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), tileGeneration(0) { }
 
         ~MMapData()
         {
@@ -46,10 +49,15 @@ namespace MMAP
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries; // instanceId to query
+        // dtNavMeshQuery is not thread safe, every thread searching the mesh gets its own
+        // instances share the mesh of their parent map, so they also share the queries of the map threads
+        std::shared_mutex navMeshQueriesLock;
+        NavMeshQuerySet navMeshQueries; // thread to query
+        // held shared by path searches running outside the map threads, adding and removing tiles waits for them
+        std::shared_mutex tilesLock;
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
+        std::atomic<uint32> tileGeneration; // changes whenever a tile is added or removed
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
@@ -66,11 +74,14 @@ namespace MMAP
         bool loadMap(uint32 mapId, int32 x, int32 y);
         bool unloadMap(uint32 mapId, int32 x, int32 y);
         bool unloadMap(uint32 mapId);
-        bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-        // the returned [dtNavMeshQuery const*] is NOT threadsafe
-        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+        // the returned [dtNavMeshQuery const*] belongs to the calling thread, do not pass it to other threads
+        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
         dtNavMesh const* GetNavMesh(uint32 mapId);
+        // poly refs found with an older generation may point to unloaded tiles
+        uint32 GetNavMeshGeneration(uint32 mapId) const;
+        // keeps the tiles of the map from being added or removed while the returned lock is held
+        std::shared_lock<std::shared_mutex> LockTiles(uint32 mapId) const;
 
         uint32 getLoadedTilesCount() const { return loadedTiles; }
         uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
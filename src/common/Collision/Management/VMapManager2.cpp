@@ -184,6 +184,29 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, Vector3 const* starts, Vector3 const* ends, bool* results, std::size_t count)
+    {
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!results[i])
+                continue;
+
+            Vector3 pos1 = convertPositionToInternalRep(starts[i].x, starts[i].y, starts[i].z);
+            Vector3 pos2 = convertPositionToInternalRep(ends[i].x, ends[i].y, ends[i].z);
+            if (pos1 != pos2 && !instanceTree->second->isInLineOfSight(pos1, pos2))
+                results[i] = false;
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
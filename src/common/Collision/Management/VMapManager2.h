@@ -109,6 +109,9 @@ namespace VMAP
         void unloadMap(unsigned int mapId) override;
 
         bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) override ;
+        // checks count segments of one map, the map tree is looked up once
+        // results of blocked segments are set to false, the others are left unchanged
+        void isInLineOfSight(unsigned int mapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, std::size_t count);
         /**
         fill the hit pos and return true, if an object was hit
         */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "TriangleBlock.h"
+#include <cmath>
+#include <cstring>
+
+#ifdef VMAP_TRIANGLE_BLOCK_SSE
+#include <emmintrin.h>
+#endif
+
+namespace VMAP
+{
+    static const float TRIANGLE_EPS = 1e-5f;
+
+    TriangleBlock::TriangleBlock()
+    {
+        memset(this, 0, sizeof(TriangleBlock));
+    }
+
+    void TriangleBlock::Set(uint32 lane, G3D::Vector3 const& v0, G3D::Vector3 const& v1, G3D::Vector3 const& v2)
+    {
+        G3D::Vector3 const e1 = v1 - v0;
+        G3D::Vector3 const e2 = v2 - v0;
+
+        v0x[lane] = v0.x; v0y[lane] = v0.y; v0z[lane] = v0.z;
+        e1x[lane] = e1.x; e1y[lane] = e1.y; e1z[lane] = e1.z;
+        e2x[lane] = e2.x; e2y[lane] = e2.y; e2z[lane] = e2.z;
+    }
+
+#ifdef VMAP_TRIANGLE_BLOCK_SSE
+
+    bool TriangleBlock::IntersectRay(G3D::Ray const& ray, float& distance) const
+    {
+        G3D::Vector3 const& origin = ray.origin();
+        G3D::Vector3 const& direction = ray.direction();
+
+        __m128 const dx = _mm_set1_ps(direction.x);
+        __m128 const dy = _mm_set1_ps(direction.y);
+        __m128 const dz = _mm_set1_ps(direction.z);
+
+        __m128 const e1X = _mm_load_ps(e1x), e1Y = _mm_load_ps(e1y), e1Z = _mm_load_ps(e1z);
+        __m128 const e2X = _mm_load_ps(e2x), e2Y = _mm_load_ps(e2y), e2Z = _mm_load_ps(e2z);
+
+        // p = direction x e2, a = e1 . p
+        __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2Z), _mm_mul_ps(dz, e2Y));
+        __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2X), _mm_mul_ps(dx, e2Z));
+        __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2Y), _mm_mul_ps(dy, e2X));
+        __m128 const a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1X, px), _mm_mul_ps(e1Y, py)), _mm_mul_ps(e1Z, pz));
+
+        // |a| >= EPS, ill-conditioned determinants (and the zeroed unused lanes) are rejected
+        __m128 const absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 mask = _mm_cmpge_ps(_mm_and_ps(a, absMask), _mm_set1_ps(TRIANGLE_EPS));
+        if (!_mm_movemask_ps(mask))
+            return false;
+
+        __m128 const zero = _mm_setzero_ps();
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const f = _mm_div_ps(one, a);
+
+        // s = origin - v0, u = f * (s . p)
+        __m128 const sx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_load_ps(v0x));
+        __m128 const sy = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_load_ps(v0y));
+        __m128 const sz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_load_ps(v0z));
+        __m128 const u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        // q = s x e1, v = f * (direction . q)
+        __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1Z), _mm_mul_ps(sz, e1Y));
+        __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1X), _mm_mul_ps(sx, e1Z));
+        __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1Y), _mm_mul_ps(sy, e1X));
+        __m128 const v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        // t = f * (e2 . q), only hits in front of the origin and closer than distance count
+        __m128 const t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2X, qx), _mm_mul_ps(e2Y, qy)), _mm_mul_ps(e2Z, qz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, _mm_set1_ps(distance))));
+
+        int hits = _mm_movemask_ps(mask);
+        if (!hits)
+            return false;
+
+        alignas(16) float times[TRIANGLE_BLOCK_SIZE];
+        _mm_store_ps(times, t);
+        for (uint32 lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+            if ((hits & (1 << lane)) && times[lane] < distance)
+                distance = times[lane];
+
+        return true;
+    }
+
+#else
+
+    bool TriangleBlock::IntersectRay(G3D::Ray const& ray, float& distance) const
+    {
+        return IntersectRayScalar(ray, distance);
+    }
+
+#endif
+
+    bool TriangleBlock::IntersectRayScalar(G3D::Ray const& ray, float& distance) const
+    {
+        G3D::Vector3 const& origin = ray.origin();
+        G3D::Vector3 const& direction = ray.direction();
+
+        bool hit = false;
+        for (uint32 lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+        {
+            G3D::Vector3 const e1(e1x[lane], e1y[lane], e1z[lane]);
+            G3D::Vector3 const e2(e2x[lane], e2y[lane], e2z[lane]);
+            G3D::Vector3 const p(direction.cross(e2));
+            float const a = e1.dot(p);
+            if (std::fabs(a) < TRIANGLE_EPS)
+                continue;
+
+            float const f = 1.0f / a;
+            G3D::Vector3 const s(origin - G3D::Vector3(v0x[lane], v0y[lane], v0z[lane]));
+            float const u = f * s.dot(p);
+            if (u < 0.0f || u > 1.0f)
+                continue;
+
+            G3D::Vector3 const q(s.cross(e1));
+            float const v = f * direction.dot(q);
+            if (v < 0.0f || (u + v) > 1.0f)
+                continue;
+
+            float const t = f * e2.dot(q);
+            if (t > 0.0f && t < distance)
+            {
+                distance = t;
+                hit = true;
+            }
+        }
+
+        return hit;
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _TRIANGLEBLOCK_H
+#define _TRIANGLEBLOCK_H
+
+#include "Define.h"
+#include <G3D/Ray.h>
+#include <G3D/Vector3.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_TRIANGLE_BLOCK_SSE
+#endif
+
+#define TRIANGLE_BLOCK_SIZE 4
+
+namespace VMAP
+{
+    /*! Four triangles prepared for ray tests, structure of arrays so all of them are tested in one SSE pass.
+        Unused lanes are zero (degenerate) and never hit.
+        The SSE2 path is selected at compile time, it is part of the x86-64 baseline so there is no runtime
+        dispatch; other targets (and 32 bit x86 builds without SSE2) test the lanes one by one. */
+    struct alignas(16) TriangleBlock
+    {
+        float v0x[TRIANGLE_BLOCK_SIZE], v0y[TRIANGLE_BLOCK_SIZE], v0z[TRIANGLE_BLOCK_SIZE];
+        float e1x[TRIANGLE_BLOCK_SIZE], e1y[TRIANGLE_BLOCK_SIZE], e1z[TRIANGLE_BLOCK_SIZE];
+        float e2x[TRIANGLE_BLOCK_SIZE], e2y[TRIANGLE_BLOCK_SIZE], e2z[TRIANGLE_BLOCK_SIZE];
+
+        TriangleBlock();
+
+        void Set(uint32 lane, G3D::Vector3 const& v0, G3D::Vector3 const& v1, G3D::Vector3 const& v2);
+
+        /*! Moller-Trumbore test of all lanes, distance is lowered to the closest hit.
+            Returns true if any triangle was hit closer than distance. */
+        bool IntersectRay(G3D::Ray const& ray, float& distance) const;
+
+        /// Scalar Moller-Trumbore test of each lane, used where SSE2 is not available
+        bool IntersectRayScalar(G3D::Ray const& ray, float& distance) const;
+    };
+}
+
+#endif
@@ -19,59 +19,6 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle& tri, std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, float& distance)
-    {
-        static const float EPS = 1e-5f;
-
-        // See RTR2 ch. 13.7 for the algorithm.
-
-        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
-        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
-        const Vector3 p(ray.direction().cross(e2));
-        const float a = e1.dot(p);
-
-        if (fabs(a) < EPS)
-        {
-            // Determinant is ill-conditioned; abort early
-            return false;
-        }
-
-        const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
-        const float u = f * s.dot(p);
-
-        if ((u < 0.0f) || (u > 1.0f))
-        {
-            // We hit the plane of the m_geometry, but outside the m_geometry
-            return false;
-        }
-
-        const Vector3 q(s.cross(e1));
-        const float v = f * ray.direction().dot(q);
-
-        if ((v < 0.0f) || ((u + v) > 1.0f))
-        {
-            // We hit the plane of the triangle, but outside the triangle
-            return false;
-        }
-
-        const float t = f * e2.dot(q);
-
-        if ((t > 0.0f) && (t < distance))
-        {
-            // This is a new hit, closer than the previous one
-            distance = t;
-
-            /* baryCoord[0] = 1.0 - u - v;
-            baryCoord[1] = u;
-            baryCoord[2] = v; */
-
-            return true;
-        }
-        // This hit is after the previous hit, so ignore it
-        return false;
-    }
-
     class TriBoundFunc
     {
     public:
@@ -252,7 +199,8 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel& other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0),
+        triangleBlocks(other.triangleBlocks), leafBlocks(other.leafBlocks)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
@@ -264,6 +212,33 @@ namespace VMAP
         triangles.swap(tri);
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
+        buildTriangleBlocks();
+    }
+
+    void GroupModel::buildTriangleBlocks()
+    {
+        triangleBlocks.clear();
+        leafBlocks.clear();
+        if (triangles.empty())
+            return;
+
+        std::vector<std::pair<uint32, uint32>> leaves;
+        meshTree.getLeaves(leaves);
+
+        // every leaf starts a new block, so one ray test touches only the blocks of its leaf
+        leafBlocks.resize(meshTree.primCount(), 0);
+        for (auto const& [first, count] : leaves)
+        {
+            leafBlocks[first] = uint32(triangleBlocks.size());
+            for (uint32 i = 0; i < count; ++i)
+            {
+                if (i % TRIANGLE_BLOCK_SIZE == 0)
+                    triangleBlocks.emplace_back();
+
+                MeshTriangle const& tri = triangles[meshTree.getObject(first + i)];
+                triangleBlocks.back().Set(i % TRIANGLE_BLOCK_SIZE, vertices[tri.idx0], vertices[tri.idx1], vertices[tri.idx2]);
+            }
+        }
     }
 
     bool GroupModel::writeToFile(FILE* wf)
@@ -346,6 +321,7 @@ namespace VMAP
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
         if (result) result = meshTree.readFromFile(rf);
+        if (result) buildTriangleBlocks();
 
         // write liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
@@ -357,16 +333,19 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) { }
-        bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*StopAtFirstHit*/)
+        GModelRayCallback(const std::vector<TriangleBlock>& blocks, const std::vector<uint32>& leafBlocks):
+            blocks(blocks), leafBlocks(leafBlocks), hit(false) { }
+        bool operator()(const G3D::Ray& ray, uint32 firstPosition, uint32 count, float& distance, bool /*StopAtFirstHit*/)
         {
-            bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
-            if (result)  hit = true;
+            uint32 block = leafBlocks[firstPosition];
+            uint32 blockCount = (count + TRIANGLE_BLOCK_SIZE - 1) / TRIANGLE_BLOCK_SIZE;
+            for (uint32 i = 0; i < blockCount; ++i)
+                if (blocks[block + i].IntersectRay(ray, distance))
+                    hit = true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const std::vector<TriangleBlock>& blocks;
+        const std::vector<uint32>& leafBlocks;
         bool hit;
     };
 
@@ -375,8 +354,8 @@ namespace VMAP
         if (triangles.empty())
             return false;
 
-        GModelRayCallback callback(triangles, vertices);
-        meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
+        GModelRayCallback callback(triangleBlocks, leafBlocks);
+        meshTree.intersectRayLeaves(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
 
@@ -384,7 +363,6 @@ namespace VMAP
     {
         if (triangles.empty() || !iBound.contains(pos))
             return false;
-        GModelRayCallback callback(triangles, vertices);
         Vector3 rPos = pos - 0.1f * down;
         float dist = G3D::inf();
         G3D::Ray ray(rPos, down);
@@ -9,6 +9,7 @@
 
 #include "Define.h"
 #include "BoundingIntervalHierarchy.h"
+#include "TriangleBlock.h"
 #include <G3D/HashTrait.h>
 #include <G3D/Vector3.h>
 #include <G3D/AABox.h>
@@ -87,6 +88,11 @@ namespace VMAP
         std::vector<MeshTriangle> triangles;
         BIH meshTree;
         WmoLiquid* iLiquid{nullptr};
+
+        //! triangles of every meshTree leaf packed into blocks, rebuilt whenever the mesh changes
+        void buildTriangleBlocks();
+        std::vector<TriangleBlock> triangleBlocks;
+        std::vector<uint32> leafBlocks;     //!< first block of the leaf starting at a meshTree position
     };
     /*! Holds a model (converted M2 or WMO) in its original coordinate space */
     class WorldModel
@@ -67,7 +67,7 @@ public:
                 delete nodes[x][y];
     }
 
-    void insert(const T& value)
+    NodeArray<Node> getNodesFor(const T& value)
     {
         G3D::Vector3 pos[9];
         pos[0] = value.getBounds().corner(0);
@@ -90,6 +90,12 @@ public:
             na.AddNode(&node);
         }
 
+        return na;
+    }
+
+    void insert(const T& value)
+    {
+        NodeArray<Node> na = getNodesFor(value);
         for (uint8 i = 0; i < 9; ++i)
         {
             if (na._nodes[i])
@@ -116,12 +122,25 @@ public:
         memberTable.remove(&value);
     }
 
-    void balance()
+    // moves the value to the nodes of its current bounds, values staying in the same nodes are only refit
+    void update(const T& value)
     {
-        for (int x = 0; x < CELL_NUMBER; ++x)
-            for (int y = 0; y < CELL_NUMBER; ++y)
-                if (Node* n = nodes[x][y])
-                    n->balance();
+        NodeArray<Node> na = getNodesFor(value);
+        NodeArray<Node>& current = memberTable[&value];
+        if (memcmp(na._nodes, current._nodes, sizeof(na._nodes)) != 0)
+        {
+            remove(value);
+            insert(value);
+            return;
+        }
+
+        for (uint8 i = 0; i < 9; ++i)
+        {
+            if (na._nodes[i])
+                na._nodes[i]->update(value);
+            else
+                break;
+        }
     }
 
     bool contains(const T& value) const { return memberTable.containsKey(&value); }
@@ -5,6 +5,7 @@
  */
 
 #include "Errors.h"
+#include "Log.h"
 #include "StringFormat.h"
 #include <cstdio>
 #include <cstdlib>
@@ -59,6 +60,7 @@ namespace Acore
     void Assert(char const* file, int line, char const* function, std::string const& debugInfo, char const* message)
     {
         std::string formattedMessage = Acore::StringFormat("\n%s:%i in %s ASSERTION FAILED:\n  %s\n", file, line, function, message) + debugInfo + '\n';
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
         Crash(formattedMessage.c_str());
@@ -72,6 +74,7 @@ namespace Acore
         std::string formattedMessage = Acore::StringFormat("\n%s:%i in %s ASSERTION FAILED:\n  %s\n", file, line, function, message) + FormatAssertionMessage(format, args) + '\n' + debugInfo + '\n';
         va_end(args);
 
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
 
@@ -86,6 +89,7 @@ namespace Acore
         std::string formattedMessage = Acore::StringFormat("\n%s:%i in %s FATAL ERROR:\n", file, line, function) + FormatAssertionMessage(message, args) + '\n';
         va_end(args);
 
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
 
@@ -96,6 +100,7 @@ namespace Acore
     void Error(char const* file, int line, char const* function, char const* message)
     {
         std::string formattedMessage = Acore::StringFormat("\n%s:%i in %s ERROR:\n  %s\n", file, line, function, message);
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
         Crash(formattedMessage.c_str());
@@ -110,6 +115,7 @@ namespace Acore
     void Abort(char const* file, int line, char const* function)
     {
         std::string formattedMessage = Acore::StringFormat("\n%s:%i in %s ABORTED.\n", file, line, function);
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
         Crash(formattedMessage.c_str());
@@ -123,6 +129,7 @@ namespace Acore
         std::string formattedMessage = StringFormat("\n%s:%i in %s ABORTED:\n", file, line, function) + FormatAssertionMessage(message, args) + '\n';
         va_end(args);
 
+        sLog->Flush();
         fprintf(stderr, "%s", formattedMessage.c_str());
         fflush(stderr);
 
@@ -30,6 +30,8 @@ public:
     void write(LogMessage* message);
     static char const* getLogLevelString(LogLevel level);
     virtual void setRealmId(uint32 /*realmId*/) { }
+    // called by the asynchronous log writer after every batch of messages
+    virtual void flush() { }
 
 private:
     virtual void _write(LogMessage const* /*message*/) = 0;
@@ -83,10 +83,18 @@ void AppenderFile::_write(LogMessage const* message)
         return;
 
     fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-    fflush(logfile);
+    // the asynchronous writer flushes once per batch
+    if (!sLog->IsAsync())
+        fflush(logfile);
     _fileSize += uint64(message->Size());
 }
 
+void AppenderFile::flush()
+{
+    if (logfile)
+        fflush(logfile);
+}
+
 FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mode, bool backup)
 {
     std::string fullName(_logDir + filename);
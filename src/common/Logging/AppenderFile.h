@@ -18,6 +18,7 @@ public:
     ~AppenderFile();
     FILE* OpenFile(std::string const& name, std::string const& mode, bool backup);
     AppenderType getType() const override { return type; }
+    void flush() override;
 
 private:
     void CloseFile();
@@ -15,10 +15,11 @@
 #include "StringConvert.h"
 #include "Util.h"
 #include "Tokenize.h"
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
+Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL), _queueSize(0), _producers(0), _queueLimit(0), _async(false), _stopWriter(false)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -203,7 +204,13 @@ void Log::RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn)
 
 void Log::outMessage(std::string const& filter, LogLevel level, std::string&& message)
 {
-    write(std::make_unique<LogMessage>(level, filter, std::move(message)));
+    outMessage(GetFilter(filter), level, std::move(message));
+}
+
+void Log::outMessage(LogFilter const* filter, LogLevel level, std::string&& message)
+{
+    if (Logger const* logger = filter->ResolvedLogger.load(std::memory_order_acquire))
+        write(logger, std::make_unique<LogMessage>(level, filter->Name, std::move(message)));
 }
 
 void Log::outCommand(std::string&& message, std::string&& param1)
@@ -211,11 +218,185 @@ void Log::outCommand(std::string&& message, std::string&& param1)
     write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", std::move(message), std::move(param1)));
 }
 
-void Log::write(std::unique_ptr<LogMessage>&& msg) const
+void Log::write(std::unique_ptr<LogMessage>&& msg)
+{
+    if (Logger const* logger = GetFilter(msg->type)->ResolvedLogger.load(std::memory_order_acquire))
+        write(logger, std::move(msg));
+}
+
+void Log::write(Logger const* logger, std::unique_ptr<LogMessage>&& msg)
 {
-    Logger const* logger = GetLoggerByType(msg->type);
+    // registered before checking _async, StopWriter clears _async before it waits for the producers
+    // so either this thread logs synchronously or StopWriter drains its message
+    _producers.fetch_add(1);
+
+    // the writer thread itself logs synchronously, it would wait for itself on a full queue
+    if (!_async.load() || std::this_thread::get_id() == _writerThreadId.load())
+    {
+        _producers.fetch_sub(1);
+        logger->write(msg.get());
+        return;
+    }
+
+    bool fatal = msg->level == LOG_LEVEL_FATAL;
+
+    // a stopped writer no longer empties the queue, StopWriter drains it once this message was added
+    while (_queueSize.load(std::memory_order_acquire) >= _queueLimit && IsAsync())
+        std::this_thread::yield();
 
-    logger->write(msg.get());
+    _queue.add(new LogOperation(logger, std::move(msg)));
+
+    // the writer only sleeps on an empty queue, the lock makes sure it is either sleeping or checks the size again
+    if (_queueSize.fetch_add(1, std::memory_order_acq_rel) == 0)
+    {
+        std::lock_guard<std::mutex> lock(_writerLock);
+        _writerCondition.notify_one();
+    }
+
+    _producers.fetch_sub(1, std::memory_order_release);
+
+    // the process is usually stopped right after a fatal message, wait until it was written and flushed
+    if (fatal)
+        Flush();
+}
+
+void Log::StartWriter(uint32 queueLimit)
+{
+    _queueLimit = std::max<uint32>(queueLimit, 1);
+    _stopWriter = false;
+    _writerThread = std::thread(&Log::WriterThread, this);
+    _writerThreadId.store(_writerThread.get_id());
+    _async.store(true, std::memory_order_release);
+}
+
+void Log::StopWriter()
+{
+    if (!_writerThread.joinable())
+        return;
+
+    _async.store(false);
+
+    {
+        std::lock_guard<std::mutex> lock(_writerLock);
+        _stopWriter = true;
+    }
+
+    _writerCondition.notify_one();
+    _writerThread.join();
+    _writerThreadId.store(std::thread::id());
+
+    // threads that saw the writer running may still be adding their message
+    while (_producers.load())
+        std::this_thread::yield();
+
+    // messages of threads that saw the writer running while it was stopped
+    LogOperation* operation;
+    while (_queue.next(operation))
+    {
+        operation->call();
+        delete operation;
+    }
+
+    _queueSize.store(0, std::memory_order_release);
+
+    for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+        appender.second->flush();
+}
+
+void Log::WriterThread()
+{
+    while (true)
+    {
+        uint32 written = 0;
+        LogOperation* operation;
+        while (_queue.next(operation))
+        {
+            operation->call();
+            delete operation;
+            ++written;
+        }
+
+        if (written)
+        {
+            for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+                appender.second->flush();
+
+            // released after the flush, so an empty queue means everything was written
+            _queueSize.fetch_sub(written, std::memory_order_acq_rel);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_writerLock);
+        if (_stopWriter && !_queueSize.load(std::memory_order_acquire))
+            break;
+
+        // a producer may still be linking a counted message, the timeout only bounds how long that is retried
+        _writerCondition.wait_for(lock, std::chrono::milliseconds(100), [this]()
+        {
+            return _stopWriter || _queueSize.load(std::memory_order_acquire);
+        });
+    }
+}
+
+void Log::SetSynchronous()
+{
+    StopWriter();
+}
+
+void Log::Flush()
+{
+    // the writer can not wait for itself, it only flushes what it wrote so far
+    if (std::this_thread::get_id() == _writerThreadId.load())
+    {
+        for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+            appender.second->flush();
+
+        return;
+    }
+
+    // bounded, a crashing process must not hang on a stuck appender; StopWriter drains the queue on its own
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (_queueSize.load(std::memory_order_acquire) && IsAsync() && std::chrono::steady_clock::now() < timeout)
+        std::this_thread::yield();
+}
+
+LogFilter const* Log::GetFilter(std::string_view type)
+{
+    std::string name(type);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_filtersLock);
+        auto itr = _filters.find(name);
+        if (itr != _filters.end())
+            return itr->second.get();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_filtersLock);
+    std::unique_ptr<LogFilter>& filter = _filters[name];
+    if (!filter)
+    {
+        filter = std::make_unique<LogFilter>(name);
+        filter->ResolvedLogger.store(GetLoggerByType(name), std::memory_order_release);
+    }
+
+    return filter.get();
+}
+
+void Log::ResolveFilters()
+{
+    std::unique_lock<std::shared_mutex> lock(_filtersLock);
+    for (std::pair<std::string const, std::unique_ptr<LogFilter>>& filter : _filters)
+        filter.second->ResolvedLogger.store(GetLoggerByType(filter.first), std::memory_order_release);
+}
+
+bool Log::IsEnabled(LogFilter const* filter, LogLevel level)
+{
+    Logger const* logger = filter->ResolvedLogger.load(std::memory_order_acquire);
+    if (!logger)
+        return false;
+
+    LogLevel logLevel = logger->getLogLevel();
+    return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
 }
 
 Logger const* Log::GetLoggerByType(std::string const& type) const
@@ -311,26 +492,19 @@ void Log::SetRealmId(uint32 id)
 
 void Log::Close()
 {
+    StopWriter();
     loggers.clear();
     appenders.clear();
+    ResolveFilters();
 }
 
-bool Log::ShouldLog(std::string const& type, LogLevel level) const
+bool Log::ShouldLog(std::string const& type, LogLevel level)
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
-
     // Don't even look for a logger if the LogLevel is higher than the highest log levels across all loggers
     if (level > highestLogLevel)
         return false;
 
-    Logger const* logger = GetLoggerByType(type);
-    if (!logger)
-        return false;
-
-    LogLevel logLevel = logger->getLogLevel();
-    return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
+    return IsEnabled(GetFilter(type), level);
 }
 
 Log* Log::instance()
@@ -358,6 +532,10 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    ResolveFilters();
 
     _debugLogMask = DebugLogFilters(sConfigMgr->GetOption<uint32>("DebugLogMask", LOG_FILTER_NONE, false));
+
+    if (sConfigMgr->GetOption<bool>("Log.Async.Enable", false, false))
+        StartWriter(sConfigMgr->GetOption<uint32>("Log.Async.QueueSize", 65536, false));
 }
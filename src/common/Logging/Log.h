@@ -8,9 +8,17 @@
 
 #include "Define.h"
 #include "LogCommon.h"
+#include "LogOperation.h"
+#include "MPSCQueue.h"
 #include "StringFormat.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -20,6 +28,16 @@ struct LogMessage;
 
 #define LOGGER_ROOT "root"
 
+/// Logger of a filter name, resolved once instead of walking the parent loggers for every message.
+/// Filters are never removed, the logger is resolved again when the configuration is loaded.
+struct LogFilter
+{
+    explicit LogFilter(std::string const& name) : Name(name), ResolvedLogger(nullptr) { }
+
+    std::string const Name;
+    std::atomic<Logger const*> ResolvedLogger;
+};
+
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs);
 
 template <class AppenderImpl>
@@ -46,7 +64,35 @@ public:
     void Initialize();
     void LoadFromConfig();
     void Close();
-    bool ShouldLog(std::string const& type, LogLevel level) const;
+    bool ShouldLog(std::string const& type, LogLevel level);
+
+    /// Used by the LOG_* macros, every call site keeps the filter it logged to last in cache.
+    /// Returns nullptr if the message would not be written.
+    LogFilter const* GetEnabledFilter(std::atomic<LogFilter const*>& cache, std::string_view type, LogLevel level)
+    {
+        // Don't even look for a logger if the LogLevel is higher than the highest log levels across all loggers
+        if (level > highestLogLevel)
+            return nullptr;
+
+        // the name is compared, the same call site may log to filter names built at runtime
+        LogFilter const* filter = cache.load(std::memory_order_acquire);
+        if (!filter || filter->Name != type)
+        {
+            filter = GetFilter(type);
+            cache.store(filter, std::memory_order_release);
+        }
+
+        return IsEnabled(filter, level) ? filter : nullptr;
+    }
+
+    /// Messages are written by a background thread if Log.Async.Enable is set.
+    bool IsAsync() const { return _async.load(std::memory_order_relaxed); }
+
+    /// Writes the queued messages and logs synchronously from then on.
+    /// Called before the databases of the DB appenders are closed.
+    void SetSynchronous();
+    /// Waits until the queued messages are written and flushed, called before the process crashes.
+    void Flush();
     bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
     template<typename Format, typename... Args>
@@ -55,6 +101,12 @@ public:
         outMessage(filter, level, Acore::StringFormat(std::forward<Format>(fmt), std::forward<Args>(args)...));
     }
 
+    template<typename Format, typename... Args>
+    inline void outMessage(LogFilter const* filter, LogLevel const level, Format&& fmt, Args&&... args)
+    {
+        outMessage(filter, level, Acore::StringFormat(std::forward<Format>(fmt), std::forward<Args>(args)...));
+    }
+
     template<typename Format, typename... Args>
     void outCommand(uint32 account, Format&& fmt, Args&&... args)
     {
@@ -154,9 +206,13 @@ public:
 
 private:
     static std::string GetTimestampStr();
-    void write(std::unique_ptr<LogMessage>&& msg) const;
+    void write(std::unique_ptr<LogMessage>&& msg);
+    void write(Logger const* logger, std::unique_ptr<LogMessage>&& msg);
 
     Logger const* GetLoggerByType(std::string const& type) const;
+    LogFilter const* GetFilter(std::string_view type);
+    void ResolveFilters();
+    static bool IsEnabled(LogFilter const* filter, LogLevel level);
     Appender* GetAppenderByName(std::string_view name);
     uint8 NextAppenderId();
     void CreateAppenderFromConfig(std::string const& name);
@@ -165,8 +221,13 @@ private:
     void ReadLoggersFromConfig();
     void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
     void outMessage(std::string const& filter, LogLevel level, std::string&& message);
+    void outMessage(LogFilter const* filter, LogLevel level, std::string&& message);
     void outCommand(std::string&& message, std::string&& param1);
 
+    void StartWriter(uint32 queueLimit);
+    void StopWriter();
+    void WriterThread();
+
     std::unordered_map<uint8, AppenderCreatorFn> appenderFactory;
     std::unordered_map<uint8, std::unique_ptr<Appender>> appenders;
     std::unordered_map<std::string, std::unique_ptr<Logger>> loggers;
@@ -178,6 +239,23 @@ private:
 
     // Deprecated debug filter logs
     DebugLogFilters _debugLogMask;
+
+    std::unordered_map<std::string, std::unique_ptr<LogFilter>> _filters;
+    std::shared_mutex _filtersLock;
+
+    // Asynchronous logging: the calling threads only queue the messages, _writerThread writes
+    // them in batches and flushes the appenders after every batch. The queue is bounded, threads
+    // logging faster than the appenders can write wait for the writer.
+    MPSCQueue<LogOperation, &LogOperation::QueueLink> _queue;
+    std::atomic<uint32> _queueSize;
+    std::atomic<uint32> _producers;         // threads that saw _async set and may still queue a message
+    uint32 _queueLimit;
+    std::atomic<bool> _async;
+    bool _stopWriter;
+    std::thread _writerThread;
+    std::atomic<std::thread::id> _writerThreadId;   // read by the logging threads while the writer is started or stopped
+    std::mutex _writerLock;
+    std::condition_variable _writerCondition;
 };
 
 #define sLog Log::instance()
@@ -204,12 +282,13 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static std::atomic<LogFilter const*> logFilterCache__;      \
+            if (LogFilter const* logFilter__ = sLog->GetEnabledFilter(logFilterCache__, filterType__, level__)) \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
                                                                         \
-                LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
+                LOG_EXCEPTION_FREE(logFilter__, level__, __VA_ARGS__);  \
             }                                                           \
         } while (0)
 #else
@@ -217,8 +296,9 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
+            static std::atomic<LogFilter const*> logFilterCache__;      \
+            if (LogFilter const* logFilter__ = sLog->GetEnabledFilter(logFilterCache__, filterType__, level__)) \
+                LOG_EXCEPTION_FREE(logFilter__, level__, __VA_ARGS__);  \
         } while (0)                                                     \
         __pragma(warning(pop))
 #endif
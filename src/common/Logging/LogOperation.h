@@ -7,6 +7,7 @@
 #define LOGOPERATION_H
 
 #include "Define.h"
+#include <atomic>
 #include <memory>
 
 class Logger;
@@ -21,6 +22,9 @@ public:
 
     int call();
 
+    // link of the asynchronous log queue
+    std::atomic<LogOperation*> QueueLink;
+
 protected:
     Logger const* logger;
     std::unique_ptr<LogMessage> msg;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/**
+ * Intrusive lock-free multiple producer single consumer queue (Dmitry Vyukov's algorithm).
+ *
+ * Items are linked through the IntrusiveLink member of T, so adding an item never allocates
+ * and an item can only be in one queue at a time.
+ * Any thread can add items; the consumer side (next, peek, empty) must not be used by
+ * two threads at the same time, but may move between threads as long as the hand over is synchronized.
+ * The queue does not own the items, remaining items have to be dequeued and deleted by the owner.
+ */
+template<typename T, std::atomic<T*> T::* IntrusiveLink>
+class MPSCQueue
+{
+public:
+    MPSCQueue() : _dummyPtr(reinterpret_cast<T*>(std::addressof(_dummy))), _head(_dummyPtr), _tail(_dummyPtr)
+    {
+        // _dummy is never constructed as T (T might not be default constructible), only its link is
+        std::atomic<T*>* dummyNext = new (&(_dummyPtr->*IntrusiveLink)) std::atomic<T*>();
+        dummyNext->store(nullptr, std::memory_order_relaxed);
+    }
+
+    MPSCQueue(MPSCQueue const&) = delete;
+    MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+    //! Adds an item to the queue, can be called from any thread.
+    void add(T* input)
+    {
+        (input->*IntrusiveLink).store(nullptr, std::memory_order_relaxed);
+        T* prevHead = _head.exchange(input, std::memory_order_acq_rel);
+        (prevHead->*IntrusiveLink).store(input, std::memory_order_release);
+    }
+
+    //! Gets the next item in the queue, if any.
+    bool next(T*& result)
+    {
+        T* tail = _tail;
+        T* next = (tail->*IntrusiveLink).load(std::memory_order_acquire);
+        if (tail == _dummyPtr)
+        {
+            if (!next)
+                return false;
+
+            _tail = next;
+            tail = next;
+            next = (next->*IntrusiveLink).load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            _tail = next;
+            result = tail;
+            return true;
+        }
+
+        // tail is the last item, unless a producer is in the middle of adding one after it
+        T* head = _head.load(std::memory_order_acquire);
+        if (tail != head)
+            return false;
+
+        add(_dummyPtr);
+        next = (tail->*IntrusiveLink).load(std::memory_order_acquire);
+        if (next)
+        {
+            _tail = next;
+            result = tail;
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Gets the next item in the queue only if the checker accepts it.
+    template<class Checker>
+    bool next(T*& result, Checker& check)
+    {
+        T* front = peek();
+        if (!front || !check.Process(front))
+            return false;
+
+        return next(result);
+    }
+
+    //! Returns the next item without removing it or nullptr if the queue is empty.
+    T* peek() const
+    {
+        T* tail = _tail;
+        if (tail == _dummyPtr)
+            tail = (tail->*IntrusiveLink).load(std::memory_order_acquire);
+
+        return tail;
+    }
+
+    bool empty() const
+    {
+        return peek() == nullptr;
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> _dummy;
+    T* _dummyPtr;
+    std::atomic<T*> _head;
+    T* _tail;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using namespace Acore;
+
+void TaskGraph::Add(std::string const& name, Task task, std::initializer_list<char const*> dependencies)
+{
+    std::size_t index = _nodes.size();
+
+    Node node;
+    node.Name = name;
+    node.Function = std::move(task);
+    node.Dependencies = 0;
+
+    for (char const* dependency : dependencies)
+    {
+        auto itr = std::find_if(_nodes.begin(), _nodes.end(), [dependency](Node const& added) { return added.Name == dependency; });
+        ASSERT(itr != _nodes.end(), "TaskGraph: task %s depends on %s, which was not added before it", name.c_str(), dependency);
+
+        itr->Dependents.push_back(index);
+        ++node.Dependencies;
+    }
+
+    _nodes.push_back(std::move(node));
+}
+
+void TaskGraph::Run(uint32 threads)
+{
+    if (threads <= 1)
+    {
+        for (Node& node : _nodes)
+            node.Function();
+
+        _nodes.clear();
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable changed;
+    // lowest index first, the tasks that were added first are usually the ones others wait for
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> ready;
+    std::size_t remaining = _nodes.size();
+
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+        if (!_nodes[i].Dependencies)
+            ready.push(i);
+
+    auto work = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            changed.wait(guard, [&]() { return !ready.empty() || !remaining; });
+            if (ready.empty())
+                return;
+
+            std::size_t index = ready.top();
+            ready.pop();
+
+            guard.unlock();
+            _nodes[index].Function();
+            guard.lock();
+
+            --remaining;
+            for (std::size_t dependent : _nodes[index].Dependents)
+                if (!--_nodes[dependent].Dependencies)
+                    ready.push(dependent);
+
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (uint32 i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+
+    work();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    _nodes.clear();
+}
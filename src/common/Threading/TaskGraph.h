@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace Acore
+{
+    /*! Named tasks with explicit dependencies, run on a number of threads.
+        A task starts once all the tasks it depends on are done. Dependencies must be added
+        before the tasks that need them, so the graph can not contain cycles and running it
+        on a single thread executes the tasks in the order they were added. */
+    class TaskGraph
+    {
+    public:
+        typedef std::function<void()> Task;
+
+        void Add(std::string const& name, Task task, std::initializer_list<char const*> dependencies = {});
+
+        // runs all tasks and blocks until they are done, the calling thread is one of the threads
+        void Run(uint32 threads);
+
+        [[nodiscard]] bool empty() const { return _nodes.empty(); }
+
+    private:
+        struct Node
+        {
+            std::string Name;
+            Task Function;
+            std::vector<std::size_t> Dependents;
+            std::size_t Dependencies;
+        };
+
+        std::vector<Node> _nodes;
+    };
+}
+
+#endif
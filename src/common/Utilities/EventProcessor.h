@@ -53,6 +53,7 @@ public:
     void KillAllEvents(bool force);
     void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
     [[nodiscard]] uint64 CalculateTime(uint64 t_offset) const;
+    [[nodiscard]] bool Empty() const { return m_events.empty(); }
 
     // Xinef: calculates next queue tick time
     [[nodiscard]] uint64 CalculateQueueTime(uint64 delay) const;
@@ -22,19 +22,18 @@
 #include "Util.h"
 #include "SignalHandler.h"
 #include "RealmList.h"
-#include "RealmAcceptor.h"
+#include "AuthSocketMgr.h"
+#include "IoContext.h"
 #include "DatabaseLoader.h"
 #include "SecretMgr.h"
 #include "SharedDefines.h"
 #include "Util.h"
 #include "ProcessPriority.h"
-#include <ace/Dev_Poll_Reactor.h>
-#include <ace/TP_Reactor.h>
 #include <ace/ACE.h>
-#include <ace/Sig_Handler.h>
 #include <boost/version.hpp>
 #include <openssl/opensslv.h>
 #include <openssl/crypto.h>
+#include <thread>
 
 #ifndef _ACORE_REALM_CONFIG
 #define _ACORE_REALM_CONFIG "authserver.conf"
@@ -101,12 +100,6 @@ extern int main(int argc, char** argv)
         }
     );
 
-#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
-    ACE_Reactor::instance(new ACE_Reactor(new ACE_Dev_Poll_Reactor(ACE::max_handles(), 1), 1), true);
-#else
-    ACE_Reactor::instance(new ACE_Reactor(new ACE_TP_Reactor(), true), true);
-#endif
-
     LOG_INFO("server.authserver", "Max allowed open files is %d", ACE::max_handles());
 
     // authserver PID file creation
@@ -130,14 +123,14 @@ extern int main(int argc, char** argv)
 
     // Get the list of realms for the server
     sRealmList->Initialize(sConfigMgr->GetOption<int32>("RealmsStateUpdateDelay", 20));
-    if (sRealmList->GetRealms().empty())
+    if (sRealmList->GetRealms()->empty())
     {
         LOG_ERROR("server.authserver", "No valid realms specified.");
         return 1;
     }
 
     // Launch the listening network socket
-    RealmAcceptor acceptor;
+    std::shared_ptr<Acore::Asio::IoContext> ioContext = std::make_shared<Acore::Asio::IoContext>();
 
     int32 rmport = sConfigMgr->GetOption<int32>("RealmServerPort", 3724);
     if (rmport < 0 || rmport > 0xFFFF)
@@ -148,15 +141,27 @@ extern int main(int argc, char** argv)
 
     std::string bind_ip = sConfigMgr->GetOption<std::string>("BindIP", "0.0.0.0");
 
-    ACE_INET_Addr bind_addr(uint16(rmport), bind_ip.c_str());
+    // 0 means one network thread per core, the login handshake is mostly SRP6 math
+    int32 networkThreads = sConfigMgr->GetOption<int32>("Network.Threads", 0);
+    if (networkThreads <= 0)
+        networkThreads = std::max<int32>(int32(std::thread::hardware_concurrency()), 1);
 
-    if (acceptor.open(bind_addr, ACE_Reactor::instance(), ACE_NONBLOCK) == -1)
+    if (!sAuthSocketMgr->StartNetwork(*ioContext, bind_ip, uint16(rmport), networkThreads))
     {
         LOG_ERROR("server.authserver", "Auth server can not bind to %s:%d (possible error: port already in use)", bind_ip.c_str(), rmport);
         return 1;
     }
 
-    LOG_INFO("server.authserver", "Authserver listening to %s:%d", bind_ip.c_str(), rmport);
+    // Run the acceptor, connections are handed over to the network threads
+    std::shared_ptr<std::thread> ioContextThread(new std::thread([ioContext]() { ioContext->run(); }),
+        [ioContext](std::thread* thr)
+    {
+        ioContext->stop();
+        thr->join();
+        delete thr;
+    });
+
+    LOG_INFO("server.authserver", "Authserver listening to %s:%d with %d network threads", bind_ip.c_str(), rmport, networkThreads);
 
     // Initialize the signal handlers
     Acore::SignalHandler signalHandler;
@@ -176,14 +181,13 @@ extern int main(int argc, char** argv)
     uint32 numLoops = (sConfigMgr->GetOption<int32>("MaxPingTime", 30) * (MINUTE * 1000000 / 100000));
     uint32 loopCounter = 0;
 
-    // Wait for termination signal
+    // Wait for termination signal, the clients are served by the network threads
     while (!stopEvent)
     {
-        // dont move this outside the loop, the reactor will modify it
-        ACE_Time_Value interval(0, 100000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-        if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
-            break;
+        // the realm list is only reloaded here, network threads read the latest loaded list
+        sRealmList->UpdateIfNeed();
 
         if ((++loopCounter) == numLoops)
         {
@@ -193,6 +197,10 @@ extern int main(int argc, char** argv)
         }
     }
 
+    // stop accepting before the acceptor is destroyed, then close the client connections
+    ioContextThread.reset();
+    sAuthSocketMgr->StopNetwork();
+
     // Close the Database Pool and library
     StopDB();
 
@@ -206,8 +214,8 @@ bool StartDB()
     MySQL::Library_Init();
 
     // Load databases
-    // NOTE: While authserver is singlethreaded you should keep synch_threads == 1.
-    // Increasing it is just silly since only 1 will be used ever.
+    // NOTE: The login handshake only uses asynchronous queries, LoginDatabase.WorkerThreads
+    // limits how many of them run at the same time.
     DatabaseLoader loader;
     loader
         .AddDatabase(LoginDatabase, "Login");
@@ -223,6 +231,9 @@ bool StartDB()
 /// Close the connection to the database
 void StopDB()
 {
+    // write the queued log messages while the DB appenders can still insert them
+    sLog->SetSynchronous();
+
     LoginDatabase.Close();
     MySQL::Library_End();
 }
@@ -2,5 +2,5 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "RealmList.h"
-#include "RealmSocket.h"
+#include "AuthSocket.h"
 #include "Common.h"
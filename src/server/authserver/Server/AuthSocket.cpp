@@ -18,14 +18,10 @@
 #include "RealmList.h"
 #include "SecretMgr.h"
 #include "TOTP.h"
-#include "Threading.h"
 #include <algorithm>
 #include <openssl/crypto.h>
-#include <openssl/md5.h>
 #include <sstream>
 
-#define ChunkSize 2048
-
 enum eAuthCmd
 {
     AUTH_LOGON_CHALLENGE                         = 0x00,
@@ -102,26 +98,11 @@ typedef struct AUTH_RECONNECT_PROOF_C
     uint8   number_of_keys;
 } sAuthReconnectProof_C;
 
-typedef struct XFER_INIT
-{
-    uint8 cmd;                                              // XFER_INITIATE
-    uint8 fileNameLen;                                      // strlen(fileName);
-    uint8 fileName[5];                                      // fileName[fileNameLen]
-    uint64 file_size;                                       // file size (bytes)
-    uint8 md5[MD5_DIGEST_LENGTH];                           // MD5
-} XFER_INIT;
-
-typedef struct XFER_DATA
-{
-    uint8 opcode;
-    uint16 data_size;
-    uint8 data[ChunkSize];
-} XFER_DATA_STRUCT;
-
 typedef struct AuthHandler
 {
     eAuthCmd cmd;
     uint32 status;
+    size_t packetSize;
     bool (AuthSocket::*handler)();
 } AuthHandler;
 
@@ -132,54 +113,21 @@ typedef struct AuthHandler
 #pragma pack(pop)
 #endif
 
-// Launch a thread to transfer a patch to the client
-class PatcherRunnable: public Acore::Runnable
-{
-public:
-    PatcherRunnable(class AuthSocket*);
-    void run() override;
-
-private:
-    AuthSocket* mySocket;
-};
-
-typedef struct PATCH_INFO
-{
-    uint8 md5[MD5_DIGEST_LENGTH];
-} PATCH_INFO;
-
-// Caches MD5 hash of client patches present on the server
-class Patcher
-{
-public:
-    typedef std::map<std::string, PATCH_INFO*> Patches;
-    ~Patcher();
-    Patcher();
-    [[nodiscard]] Patches::const_iterator begin() const { return _patches.begin(); }
-    [[nodiscard]] Patches::const_iterator end() const { return _patches.end(); }
-    void LoadPatchMD5(char*);
-    bool GetHash(char* pat, uint8 mymd5[16]);
-
-private:
-    void LoadPatchesInfo();
-    Patches _patches;
-};
-
 std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B, 0x21, 0x57, 0xFC, 0x37, 0x3F, 0xB3, 0x69, 0xCD, 0xD2, 0xF1 } };
 
+#define AUTH_LOGON_CHALLENGE_INITIAL_SIZE 4
+#define REALM_LIST_PACKET_SIZE 5
+
 const AuthHandler table[] =
 {
-    { AUTH_LOGON_CHALLENGE,     STATUS_CHALLENGE,   &AuthSocket::_HandleLogonChallenge      },
-    { AUTH_LOGON_PROOF,         STATUS_LOGON_PROOF, &AuthSocket::_HandleLogonProof          },
-    { AUTH_RECONNECT_CHALLENGE, STATUS_CHALLENGE,   &AuthSocket::_HandleReconnectChallenge  },
-    { AUTH_RECONNECT_PROOF,     STATUS_RECON_PROOF, &AuthSocket::_HandleReconnectProof      },
-    { REALM_LIST,               STATUS_AUTHED,      &AuthSocket::_HandleRealmList           },
-    { XFER_ACCEPT,              STATUS_PATCH,       &AuthSocket::_HandleXferAccept          },
-    { XFER_RESUME,              STATUS_PATCH,       &AuthSocket::_HandleXferResume          },
-    { XFER_CANCEL,              STATUS_PATCH,       &AuthSocket::_HandleXferCancel          }
+    { AUTH_LOGON_CHALLENGE,     STATUS_CHALLENGE,   AUTH_LOGON_CHALLENGE_INITIAL_SIZE,  &AuthSocket::_HandleLogonChallenge      },
+    { AUTH_LOGON_PROOF,         STATUS_LOGON_PROOF, sizeof(sAuthLogonProof_C),          &AuthSocket::_HandleLogonProof          },
+    { AUTH_RECONNECT_CHALLENGE, STATUS_CHALLENGE,   AUTH_LOGON_CHALLENGE_INITIAL_SIZE,  &AuthSocket::_HandleReconnectChallenge  },
+    { AUTH_RECONNECT_PROOF,     STATUS_RECON_PROOF, sizeof(sAuthReconnectProof_C),      &AuthSocket::_HandleReconnectProof      },
+    { REALM_LIST,               STATUS_AUTHED,      REALM_LIST_PACKET_SIZE,             &AuthSocket::_HandleRealmList           }
 };
 
-#define AUTH_TOTAL_COMMANDS 8
+#define AUTH_TOTAL_COMMANDS 5
 
 void AccountInfo::LoadResult(Field* fields)
 {
@@ -205,34 +153,81 @@ void AccountInfo::LoadResult(Field* fields)
     Utf8ToUpperOnlyLatin(Login);
 }
 
-// Holds the MD5 hash of client patches present on the server
-Patcher PatchesCache;
-
-// Constructor - set the N and g values for SRP6
-AuthSocket::AuthSocket(RealmSocket& socket) :
-    pPatch(nullptr), socket_(socket), _status(STATUS_CHALLENGE), _build(0),
-    _expversion(0)
+AuthSocket::AuthSocket(tcp::socket&& socket) : AuthSocketBase(std::move(socket)),
+    _status(STATUS_CHALLENGE), _ipAddress(GetRemoteIpAddress().to_string()), _build(0), _expversion(0)
 {
 }
 
-// Close patch file descriptor before leaving
 AuthSocket::~AuthSocket() = default;
 
 // Accept the connection
-void AuthSocket::OnAccept()
+void AuthSocket::Start()
 {
-    LOG_INFO("server", "'%s:%d' Accepting connection", socket().getRemoteAddress().c_str(), socket().getRemotePort());
+    LOG_INFO("server", "'%s:%d' Accepting connection", _ipAddress.c_str(), GetRemotePort());
+
+    AsyncRead();
 }
 
-void AuthSocket::OnClose()
+bool AuthSocket::Update()
 {
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "AuthSocket::OnClose");
-#endif
+    // the pending callbacks keep the socket alive, drop them once it is closed
+    if (!AuthSocketBase::Update())
+    {
+        _queryCallbacks.clear();
+        return false;
+    }
+
+    ProcessQueryCallbacks();
+    return true;
+}
+
+void AuthSocket::AddQueryCallback(PreparedQueryResultFuture future, QueryCallbackHandler&& handler)
+{
+    _queryCallbacks.emplace_back(std::move(future), std::move(handler));
 }
 
-// Read the packet from the client
-void AuthSocket::OnRead()
+void AuthSocket::ProcessQueryCallbacks()
+{
+    if (_queryCallbacks.empty())
+        return;
+
+    // callbacks may queue the next query of their chain, collect the finished ones first
+    std::vector<std::pair<PreparedQueryResult, QueryCallbackHandler>> ready;
+    _queryCallbacks.erase(std::remove_if(_queryCallbacks.begin(), _queryCallbacks.end(), [&ready](std::pair<PreparedQueryResultFuture, QueryCallbackHandler>& callback)
+    {
+        if (!callback.first.ready())
+            return false;
+
+        PreparedQueryResult result;
+        callback.first.get(result);
+        ready.emplace_back(std::move(result), std::move(callback.second));
+        return true;
+    }), _queryCallbacks.end());
+
+    for (std::pair<PreparedQueryResult, QueryCallbackHandler>& callback : ready)
+    {
+        if (!IsOpen())
+            return;
+
+        callback.second(std::move(callback.first));
+    }
+}
+
+void AuthSocket::SendPacket(ByteBuffer& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (!packet.empty())
+    {
+        MessageBuffer buffer(packet.size());
+        buffer.Write(packet.contents(), packet.size());
+        QueuePacket(std::move(buffer));
+    }
+}
+
+// Read the packets from the client, a handler is only called once its whole packet is received
+void AuthSocket::ReadHandler()
 {
 #define MAX_AUTH_LOGON_CHALLENGES_IN_A_ROW 3
     uint32 challengesInARow = 0;
@@ -240,19 +235,68 @@ void AuthSocket::OnRead()
 #define MAX_AUTH_GET_REALM_LIST 10
     uint32 challengesInARowRealmList = 0;
 
-    uint8 _cmd;
-    while (true)
+    MessageBuffer& packet = GetReadBuffer();
+    while (packet.GetActiveSize())
     {
-        if (!socket().recv_soft((char*)&_cmd, 1))
+        uint8 _cmd = packet.GetReadPointer()[0];
+
+        size_t i;
+
+        // Circle through known commands and call the correct command handler
+        for (i = 0; i < AUTH_TOTAL_COMMANDS; ++i)
+            if ((uint8)table[i].cmd == _cmd && (table[i].status == _status))
+                break;
+
+        // Report unknown packets in the error log
+        if (i == AUTH_TOTAL_COMMANDS)
+        {
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
+            LOG_DEBUG("network", "Got unknown packet from '%s'", _ipAddress.c_str());
+#endif
+            CloseSocket();
             return;
+        }
+
+        size_t size = table[i].packetSize;
+        if (packet.GetActiveSize() < size)
+            break;
+
+        if (_cmd == AUTH_LOGON_CHALLENGE || _cmd == AUTH_RECONNECT_CHALLENGE)
+        {
+            // the header only contains the size of the rest of the packet
+            uint16 remaining = *reinterpret_cast<uint16 const*>(packet.GetReadPointer() + 2);
+            EndianConvert(remaining);
+#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
+            LOG_DEBUG("network", "[AuthChallenge] got header, body is %#04x bytes", remaining);
+#endif
+
+            if (remaining < sizeof(sAuthLogonChallenge_C) - AUTH_LOGON_CHALLENGE_INITIAL_SIZE)
+            {
+                CloseSocket();
+                return;
+            }
+
+            size += remaining;
+        }
+        else if (_cmd == AUTH_LOGON_PROOF && (reinterpret_cast<sAuthLogonProof_C const*>(packet.GetReadPointer())->securityFlags & 0x04))
+        {
+            // the security token follows the proof, prefixed by its length
+            if (packet.GetActiveSize() == size)
+                break;
+
+            size += 1 + packet.GetReadPointer()[size];
+        }
+
+        if (packet.GetActiveSize() < size)
+            break;
 
         if (_cmd == AUTH_LOGON_CHALLENGE)
         {
             ++challengesInARow;
             if (challengesInARow == MAX_AUTH_LOGON_CHALLENGES_IN_A_ROW)
             {
-                LOG_INFO("server", "Got %u AUTH_LOGON_CHALLENGE in a row from '%s', possible ongoing DoS", challengesInARow, socket().getRemoteAddress().c_str());
-                socket().shutdown();
+                LOG_INFO("server", "Got %u AUTH_LOGON_CHALLENGE in a row from '%s', possible ongoing DoS", challengesInARow, _ipAddress.c_str());
+                CloseSocket();
                 return;
             }
         }
@@ -261,49 +305,39 @@ void AuthSocket::OnRead()
             challengesInARowRealmList++;
             if (challengesInARowRealmList == MAX_AUTH_GET_REALM_LIST)
             {
-                LOG_INFO("server", "Got %u REALM_LIST in a row from '%s', possible ongoing DoS", challengesInARowRealmList, socket().getRemoteAddress().c_str());
-                socket().shutdown();
+                LOG_INFO("server", "Got %u REALM_LIST in a row from '%s', possible ongoing DoS", challengesInARowRealmList, _ipAddress.c_str());
+                CloseSocket();
                 return;
             }
         }
 
-        size_t i;
-
-        // Circle through known commands and call the correct command handler
-        for (i = 0; i < AUTH_TOTAL_COMMANDS; ++i)
-        {
-            if ((uint8)table[i].cmd == _cmd && (table[i].status == _status))
-            {
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                LOG_DEBUG("network", "Got data for cmd %u recv length %u", (uint32)_cmd, (uint32)socket().recv_len());
-#endif
-
-                if (!(*this.*table[i].handler)())
-                {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                    LOG_DEBUG("network", "Command handler failed for cmd %u recv length %u", (uint32)_cmd, (uint32)socket().recv_len());
+        LOG_DEBUG("network", "Got data for cmd %u recv length %u", (uint32)_cmd, (uint32)packet.GetActiveSize());
 #endif
-                    return;
-                }
-                break;
-            }
-        }
 
-        // Report unknown packets in the error log
-        if (i == AUTH_TOTAL_COMMANDS)
+        if (!(*this.*table[i].handler)())
         {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-            LOG_DEBUG("network", "Got unknown packet from '%s'", socket().getRemoteAddress().c_str());
+            LOG_DEBUG("network", "Command handler failed for cmd %u recv length %u", (uint32)_cmd, (uint32)packet.GetActiveSize());
 #endif
-            socket().shutdown();
+            CloseSocket();
             return;
         }
+
+        packet.ReadCompleted(size);
     }
+
+    AsyncRead();
 }
 
-std::map<std::string, uint32> LastLoginAttemptTimeForIP;
-uint32 LastLoginAttemptCleanTime = 0;
-std::mutex LastLoginAttemptMutex;
+void AuthSocket::SendLogonChallengeError(uint8 error)
+{
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+    pkt << uint8(error);
+    SendPacket(pkt);
+}
 
 // Logon Challenge command handler
 bool AuthSocket::_HandleLogonChallenge()
@@ -311,38 +345,18 @@ bool AuthSocket::_HandleLogonChallenge()
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     LOG_DEBUG("network", "Entering _HandleLogonChallenge");
 #endif
-    if (socket().recv_len() < sizeof(sAuthLogonChallenge_C))
-        return false;
 
     ///- Session is closed unless overriden
     _status = STATUS_CLOSED;
 
-    // Read the first 4 bytes (header) to get the length of the remaining of the packet
-    std::vector<uint8> buf;
-    buf.resize(4);
-
-    socket().recv((char*)&buf[0], 4);
-
-    EndianConvertPtr<uint16>(&buf[0]);
+    sAuthLogonChallenge_C* ch = reinterpret_cast<sAuthLogonChallenge_C*>(GetReadBuffer().GetReadPointer());
+    EndianConvert(ch->size);
 
-    uint16 remaining = ((sAuthLogonChallenge_C*)&buf[0])->size;
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "[AuthChallenge] got header, body is %#04x bytes", remaining);
-#endif
-
-    if ((remaining < sizeof(sAuthLogonChallenge_C) - buf.size()) || (socket().recv_len() < remaining))
+    if (ch->size - (sizeof(sAuthLogonChallenge_C) - AUTH_LOGON_CHALLENGE_INITIAL_SIZE - 1) < ch->I_len)
         return false;
 
-    //No big fear of memory outage (size is int16, i.e. < 65536)
-    buf.resize(remaining + buf.size() + 1);
-    buf[buf.size() - 1] = 0;
-    sAuthLogonChallenge_C* ch = (sAuthLogonChallenge_C*)&buf[0];
-
-    // Read the remaining of the packet
-    socket().recv((char*)&buf[4], remaining);
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     LOG_DEBUG("network", "[AuthChallenge] got full packet, %#04x bytes", ch->size);
-    LOG_DEBUG("network", "[AuthChallenge] name(%d): '%s'", ch->I_len, ch->I);
 #endif
 
     // BigEndian code, nop in little endian case
@@ -360,10 +374,7 @@ bool AuthSocket::_HandleLogonChallenge()
 
     _build = ch->build;
     _expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
-    _os = (const char*)ch->os;
-
-    if (_os.size() > 4)
-        return false;
+    _os.assign((char const*)ch->os, strnlen((char const*)ch->os, sizeof(ch->os)));
 
     // Restore string order as its byte order is reversed
     std::reverse(_os.begin(), _os.end());
@@ -372,79 +383,40 @@ bool AuthSocket::_HandleLogonChallenge()
     for (int i = 0; i < 4; ++i)
         _localizationName[i] = ch->country[4 - i - 1];
 
-    ByteBuffer pkt;
-    pkt << uint8(AUTH_LOGON_CHALLENGE);
-    pkt << uint8(0x00);
-
-    auto SendAuthPacket = [&]()
-    {
-        socket().send((char const*)pkt.contents(), pkt.size());
-    };
-
     // Verify that this IP is not in the ip_banned table
     LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_DEL_EXPIRED_IP_BANS));
 
-    std::string const& ipAddress = socket().getRemoteAddress();
-    uint32 port = socket().getRemotePort();
-
     // Get the account details from the account table
     // No SQL injection (prepared statement)
-    auto stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGONCHALLENGE);
     stmt->setString(0, login);
 
-    PreparedQueryResult res2 = LoginDatabase.Query(stmt);
-    if (!res2) //no account
+    AddQueryCallback(LoginDatabase.AsyncQuery(stmt), std::bind(&AuthSocket::LogonChallengeCallback, shared_from_this(), std::placeholders::_1));
+    return true;
+}
+
+void AuthSocket::LogonChallengeCallback(PreparedQueryResult result)
+{
+    if (!result) //no account
     {
-        pkt << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
-        SendAuthPacket();
-        return true;
+        SendLogonChallengeError(WOW_FAIL_UNKNOWN_ACCOUNT);
+        return;
     }
 
-    Field* fields = res2->Fetch();
+    Field* fields = result->Fetch();
 
     _accountInfo.LoadResult(fields);
 
     // If the IP is 'locked', check that the player comes indeed from the correct IP address
     if (_accountInfo.IsLockedToIP)
     {
-        LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to IP - '%s' is logging in from '%s'", _accountInfo.Login.c_str(), _accountInfo.LastIP.c_str(), ipAddress.c_str());
+        LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' is locked to IP - '%s' is logging in from '%s'", _accountInfo.Login.c_str(), _accountInfo.LastIP.c_str(), _ipAddress.c_str());
 
-        if (_accountInfo.LastIP != ipAddress)
+        if (_accountInfo.LastIP != _ipAddress)
         {
             LOG_DEBUG("network", "[AuthChallenge] Account IP differs");
-            pkt << uint8(WOW_FAIL_LOCKED_ENFORCED);
-            SendAuthPacket();
-            return true;
-        }
-    }
-    else
-    {
-        LOG_DEBUG("network", "[AuthChallenge] Account '%s' is not locked to ip", _accountInfo.Login.c_str());
-
-        if (_accountInfo.LockCountry.empty() || _accountInfo.LockCountry == "00")
-        {
-            LOG_DEBUG("network", "[AuthChallenge] Account '%s' is not locked to country", _accountInfo.Login.c_str());
-        }
-        else if (!_accountInfo.LockCountry.empty())
-        {
-            uint32 ip = inet_addr(ipAddress.c_str());
-            EndianConvertReverse(ip);
-
-            stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGON_COUNTRY);
-            stmt->setUInt32(0, ip);
-
-            if (PreparedQueryResult sessionCountryQuery = LoginDatabase.Query(stmt))
-            {
-                std::string loginCountry = (*sessionCountryQuery)[0].GetString();
-                LOG_DEBUG("network", "[AuthChallenge] Account '%s' is locked to country: '%s' Player country is '%s'", _accountInfo.Login.c_str(), _accountInfo.LockCountry.c_str(), loginCountry.c_str());
-                if (loginCountry != _accountInfo.LockCountry)
-                {
-                    LOG_DEBUG("network", "[AuthChallenge] Account country differs.");
-                    pkt << uint8(WOW_FAIL_UNLOCKABLE_LOCK);
-                    SendAuthPacket();
-                    return true;
-                }
-            }
+            SendLogonChallengeError(WOW_FAIL_LOCKED_ENFORCED);
+            return;
         }
     }
 
@@ -453,54 +425,98 @@ bool AuthSocket::_HandleLogonChallenge()
     {
         if (_accountInfo.IsPermanenetlyBanned)
         {
-            pkt << uint8(WOW_FAIL_BANNED);
-            LOG_DEBUG("server.authserver.banned", "'%s:%d' [AuthChallenge] Banned account %s tried to login!", ipAddress.c_str(), port, _accountInfo.Login.c_str());
+            SendLogonChallengeError(WOW_FAIL_BANNED);
+            LOG_DEBUG("server.authserver.banned", "'%s:%d' [AuthChallenge] Banned account %s tried to login!", _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str());
         }
         else
         {
-            pkt << uint8(WOW_FAIL_SUSPENDED);
-            LOG_DEBUG("server.authserver.banned", "'%s:%d' [AuthChallenge] Temporarily banned account %s tried to login!", ipAddress.c_str(), port, _accountInfo.Login.c_str());
+            SendLogonChallengeError(WOW_FAIL_SUSPENDED);
+            LOG_DEBUG("server.authserver.banned", "'%s:%d' [AuthChallenge] Temporarily banned account %s tried to login!", _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str());
         }
 
-        SendAuthPacket();
-        return true;
+        return;
     }
 
-    uint8 securityFlags = 0;
-
     // Check if a TOTP token is needed
     if (sConfigMgr->GetOption<bool>("EnableTOTP", false) && !fields[9].IsNull())
     {
         LOG_DEBUG("server.authserver", "[AuthChallenge] Account '%s' using TOTP", _accountInfo.Login.c_str());
 
-        securityFlags = 4;
         _totpSecret = fields[9].GetBinary();
         if (auto const& secret = sSecretMgr->GetSecret(SECRET_TOTP_MASTER_KEY))
         {
             bool success = Acore::Crypto::AEDecrypt<Acore::Crypto::AES>(*_totpSecret, *secret);
             if (!success)
             {
-                pkt << uint8(WOW_FAIL_DB_BUSY);
                 LOG_ERROR("server.authserver", "[AuthChallenge] Account '%s' has invalid ciphertext for TOTP token key stored", _accountInfo.Login.c_str());
-                SendAuthPacket();
-                return true;
+                SendLogonChallengeError(WOW_FAIL_DB_BUSY);
+                return;
             }
         }
     }
 
-    _srp6.emplace(
-        _accountInfo.Login,
-        fields[10].GetBinary<Acore::Crypto::SRP6::SALT_LENGTH>(),
-        fields[11].GetBinary<Acore::Crypto::SRP6::VERIFIER_LENGTH>());
+    _salt = fields[10].GetBinary<Acore::Crypto::SRP6::SALT_LENGTH>();
+    _verifier = fields[11].GetBinary<Acore::Crypto::SRP6::VERIFIER_LENGTH>();
+
+    if (!_accountInfo.IsLockedToIP)
+    {
+        LOG_DEBUG("network", "[AuthChallenge] Account '%s' is not locked to ip", _accountInfo.Login.c_str());
 
+        if (_accountInfo.LockCountry.empty() || _accountInfo.LockCountry == "00")
+        {
+            LOG_DEBUG("network", "[AuthChallenge] Account '%s' is not locked to country", _accountInfo.Login.c_str());
+        }
+        else
+        {
+            uint32 ip = inet_addr(_ipAddress.c_str());
+            EndianConvertReverse(ip);
+
+            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LOGON_COUNTRY);
+            stmt->setUInt32(0, ip);
+
+            AddQueryCallback(LoginDatabase.AsyncQuery(stmt), std::bind(&AuthSocket::LogonChallengeCountryCallback, shared_from_this(), std::placeholders::_1));
+            return;
+        }
+    }
+
+    SendLogonChallengeResponse();
+}
+
+void AuthSocket::LogonChallengeCountryCallback(PreparedQueryResult result)
+{
+    if (result)
+    {
+        std::string loginCountry = (*result)[0].GetString();
+        LOG_DEBUG("network", "[AuthChallenge] Account '%s' is locked to country: '%s' Player country is '%s'", _accountInfo.Login.c_str(), _accountInfo.LockCountry.c_str(), loginCountry.c_str());
+        if (loginCountry != _accountInfo.LockCountry)
+        {
+            LOG_DEBUG("network", "[AuthChallenge] Account country differs.");
+            SendLogonChallengeError(WOW_FAIL_UNLOCKABLE_LOCK);
+            return;
+        }
+    }
+
+    SendLogonChallengeResponse();
+}
+
+void AuthSocket::SendLogonChallengeResponse()
+{
     // Fill the response packet with the result
     if (!AuthHelper::IsAcceptedClientBuild(_build))
     {
-        pkt << uint8(WOW_FAIL_VERSION_INVALID);
-        SendAuthPacket();
-        return true;
+        SendLogonChallengeError(WOW_FAIL_VERSION_INVALID);
+        return;
     }
 
+    uint8 securityFlags = 0;
+    if (_totpSecret)
+        securityFlags = 4;
+
+    _srp6.emplace(_accountInfo.Login, _salt, _verifier);
+
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
     pkt << uint8(WOW_SUCCESS);
 
     // B may be calculated < 32B so we force minimal length to 32B
@@ -532,13 +548,12 @@ bool AuthSocket::_HandleLogonChallenge()
         pkt << uint8(1);
 
     LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s is using locale (%u)",
-        ipAddress.c_str(), port, _accountInfo.Login.c_str(), GetLocaleByName(_localizationName));
+        _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str(), GetLocaleByName(_localizationName));
 
     ///- All good, await client's proof
     _status = STATUS_LOGON_PROOF;
 
-    SendAuthPacket();
-    return true;
+    SendPacket(pkt);
 }
 
 // Logon Proof command handler
@@ -548,11 +563,7 @@ bool AuthSocket::_HandleLogonProof()
 
     // Read the packet
     sAuthLogonProof_C lp;
-
-    if (!socket().recv((char*)&lp, sizeof(sAuthLogonProof_C)))
-    {
-        return false;
-    }
+    memcpy(&lp, GetReadBuffer().GetReadPointer(), sizeof(sAuthLogonProof_C));
 
     _status = STATUS_CLOSED;
 
@@ -561,8 +572,7 @@ bool AuthSocket::_HandleLogonProof()
     {
         // Check if we have the appropriate patch on the disk
         LOG_DEBUG("network", "Client with invalid version, patching is not implemented");
-        socket().shutdown();
-        return true;
+        return false;
     }
 
     if (std::optional<SessionKey> K = _srp6->VerifyChallengeResponse(lp.A, lp.clientM))
@@ -575,13 +585,9 @@ bool AuthSocket::_HandleLogonProof()
 
         if (sentToken && _totpSecret)
         {
-            uint8 size;
-            socket().recv((char*)&size, 1);
-            char* token = new char[size + 1];
-            token[size] = '\0';
-            socket().recv(token, size);
-            unsigned int incomingToken = atoi(token);
-            delete[] token;
+            uint8 const* tokenData = GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C);
+            std::string token(reinterpret_cast<char const*>(tokenData + 1), tokenData[0]);
+            unsigned int incomingToken = atoi(token.c_str());
 
             tokenSuccess = Acore::Crypto::TOTP::ValidateToken(*_totpSecret, incomingToken);
             memset(_totpSecret->data(), 0, _totpSecret->size());
@@ -592,25 +598,29 @@ bool AuthSocket::_HandleLogonProof()
         if (!tokenSuccess)
         {
             LOG_DEBUG("server.authsrver", "[AuthChallenge] account %s failed token", _accountInfo.Login.c_str());
-            char data[4] = { AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0 };
-            socket().send(data, sizeof(data));
+            ByteBuffer pkt;
+            pkt << uint8(AUTH_LOGON_PROOF) << uint8(WOW_FAIL_UNKNOWN_ACCOUNT) << uint16(3);
+            SendPacket(pkt);
+            return true;
         }
 
-        LOG_DEBUG("network", "'%s:%d' User '%s' successfully authenticated", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _accountInfo.Login.c_str());
+        LOG_DEBUG("network", "'%s:%d' User '%s' successfully authenticated", _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str());
+
+        // Finish SRP6 and send the final result to the client
+        Acore::Crypto::SHA1::Digest M2 = Acore::Crypto::SRP6::GetSessionVerifier(lp.A, lp.clientM, _sessionKey);
 
         // Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
         // No SQL injection (escaped user name) and IP address as received by socket
+        // Ordered by account, the realm list query of this account only runs once the session key is stored
         PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_LOGONPROOF);
         stmt->setBinary(0, _sessionKey);
-        stmt->setString(1, socket().getRemoteAddress().c_str());
+        stmt->setString(1, _ipAddress);
         stmt->setUInt32(2, GetLocaleByName(_localizationName));
         stmt->setString(3, _os);
         stmt->setString(4, _accountInfo.Login);
-        LoginDatabase.DirectExecute(stmt);
-
-        // Finish SRP6 and send the final result to the client
-        Acore::Crypto::SHA1::Digest M2 = Acore::Crypto::SRP6::GetSessionVerifier(lp.A, lp.clientM, _sessionKey);
+        LoginDatabase.Execute(stmt, _accountInfo.Id);
 
+        ByteBuffer pkt;
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
         {
             sAuthLogonProof_S proof;
@@ -620,7 +630,7 @@ bool AuthSocket::_HandleLogonProof()
             proof.unk1 = 0x00800000;    // Accountflags. 0x01 = GM, 0x08 = Trial, 0x00800000 = Pro pass (arena tournament)
             proof.unk2 = 0x00;          // SurveyId
             proof.unk3 = 0x00;          // 0x1 = has account message
-            socket().send((char*)&proof, sizeof(proof));
+            pkt.append((uint8 const*)&proof, sizeof(proof));
         }
         else
         {
@@ -629,19 +639,22 @@ bool AuthSocket::_HandleLogonProof()
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.unk2 = 0x00;
-            socket().send((char*)&proof, sizeof(proof));
+            pkt.append((uint8 const*)&proof, sizeof(proof));
         }
 
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
+
+        SendPacket(pkt);
     }
     else
     {
-        char data[4] = { AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0 };
-        socket().send(data, sizeof(data));
+        ByteBuffer pkt;
+        pkt << uint8(AUTH_LOGON_PROOF) << uint8(WOW_FAIL_UNKNOWN_ACCOUNT) << uint16(3);
+        SendPacket(pkt);
 
         LOG_INFO("server.authserver.hack", "'%s:%d' [AuthChallenge] account %s tried to login with invalid password!",
-            socket().getRemoteAddress().c_str(), socket().getRemotePort(), _accountInfo.Login.c_str());
+            _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str());
 
         uint32 MaxWrongPassCount = sConfigMgr->GetOption<int32>("WrongPass.MaxCount", 0);
 
@@ -650,7 +663,7 @@ bool AuthSocket::_HandleLogonProof()
         {
             PreparedStatement* logstmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_FALP_IP_LOGGING);
             logstmt->setString(0, _accountInfo.Login);
-            logstmt->setString(1, socket().getRemoteAddress());
+            logstmt->setString(1, _ipAddress);
             logstmt->setString(2, "Logged on failed AccountLogin due wrong password");
 
             LoginDatabase.Execute(logstmt);
@@ -676,17 +689,17 @@ bool AuthSocket::_HandleLogonProof()
                     LoginDatabase.Execute(stmt);
 
                     LOG_DEBUG("network", "'%s:%d' [AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                        socket().getRemoteAddress().c_str(), socket().getRemotePort(), _accountInfo.Login.c_str(), WrongPassBanTime, _accountInfo.FailedLogins);
+                        _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str(), WrongPassBanTime, _accountInfo.FailedLogins);
                 }
                 else
                 {
                     stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
-                    stmt->setString(0, socket().getRemoteAddress());
+                    stmt->setString(0, _ipAddress);
                     stmt->setUInt32(1, WrongPassBanTime);
                     LoginDatabase.Execute(stmt);
 
                     LOG_DEBUG("network", "'%s:%d' [AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                        socket().getRemoteAddress().c_str(), socket().getRemotePort(), socket().getRemoteAddress().c_str(), WrongPassBanTime, _accountInfo.Login.c_str(), _accountInfo.FailedLogins);
+                        _ipAddress.c_str(), GetRemotePort(), _ipAddress.c_str(), WrongPassBanTime, _accountInfo.Login.c_str(), _accountInfo.FailedLogins);
                 }
             }
         }
@@ -700,38 +713,17 @@ bool AuthSocket::_HandleReconnectChallenge()
 {
     LOG_TRACE("network", "Entering _HandleReconnectChallenge");
 
-    if (socket().recv_len() < sizeof(sAuthLogonChallenge_C))
-        return false;
-
-    // Read the first 4 bytes (header) to get the length of the remaining of the packet
-    std::vector<uint8> buf;
-    buf.resize(4);
-
-    socket().recv((char*)&buf[0], 4);
-
-    EndianConvertPtr<uint16>(&buf[0]);
-
-    uint16 remaining = ((sAuthLogonChallenge_C*)&buf[0])->size;
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "[ReconnectChallenge] got header, body is %#04x bytes", remaining);
-#endif
-
-    if ((remaining < sizeof(sAuthLogonChallenge_C) - buf.size()) || (socket().recv_len() < remaining))
-        return false;
-
     ///- Session is closed unless overriden
     _status = STATUS_CLOSED;
 
-    // No big fear of memory outage (size is int16, i.e. < 65536)
-    buf.resize(remaining + buf.size() + 1);
-    buf[buf.size() - 1] = 0;
-    sAuthLogonChallenge_C* ch = (sAuthLogonChallenge_C*)&buf[0];
+    sAuthLogonChallenge_C* ch = reinterpret_cast<sAuthLogonChallenge_C*>(GetReadBuffer().GetReadPointer());
+    EndianConvert(ch->size);
+
+    if (ch->size - (sizeof(sAuthLogonChallenge_C) - AUTH_LOGON_CHALLENGE_INITIAL_SIZE - 1) < ch->I_len)
+        return false;
 
-    // Read the remaining of the packet
-    socket().recv((char*)&buf[4], remaining);
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     LOG_DEBUG("network", "[ReconnectChallenge] got full packet, %#04x bytes", ch->size);
-    LOG_DEBUG("network", "[ReconnectChallenge] name(%d): '%s'", ch->I_len, ch->I);
 #endif
 
     std::string login((char const*)ch->I, ch->I_len);
@@ -740,30 +732,35 @@ bool AuthSocket::_HandleReconnectChallenge()
     // Reinitialize build, expansion and the account securitylevel
     _build = ch->build;
     _expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
-    _os = (const char*)ch->os;
+    _os.assign((char const*)ch->os, strnlen((char const*)ch->os, sizeof(ch->os)));
 
-    if (_os.size() > 4)
-        return false;
+    // Restore string order as its byte order is reversed
+    std::reverse(_os.begin(), _os.end());
 
-    auto* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_RECONNECTCHALLENGE);
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_RECONNECTCHALLENGE);
     stmt->setString(0, login);
 
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
-
-    // Stop if the account is not found
-    if (!result)
+    AddQueryCallback(LoginDatabase.AsyncQuery(stmt), [self = shared_from_this(), login](PreparedQueryResult result)
     {
-        LOG_ERROR("server", "'%s:%d' [ERROR] user %s tried to login and we cannot find his session key in the database.", socket().getRemoteAddress().c_str(), socket().getRemotePort(), login.c_str());
-        socket().shutdown();
-        return false;
-    }
+        // Stop if the account is not found
+        if (!result)
+        {
+            LOG_ERROR("server", "'%s:%d' [ERROR] user %s tried to login and we cannot find his session key in the database.", self->_ipAddress.c_str(), self->GetRemotePort(), login.c_str());
+            self->CloseSocket();
+            return;
+        }
+
+        self->ReconnectChallengeCallback(std::move(result));
+    });
 
+    return true;
+}
+
+void AuthSocket::ReconnectChallengeCallback(PreparedQueryResult result)
+{
     Field* fields = result->Fetch();
     _accountInfo.LoadResult(fields);
 
-    // Restore string order as its byte order is reversed
-    std::reverse(_os.begin(), _os.end());
-
     _sessionKey = fields[9].GetBinary<SESSION_KEY_LENGTH>();
     Acore::Crypto::GetRandomBytes(_reconnectProof);
 
@@ -776,8 +773,7 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt << uint8(WOW_SUCCESS);
     pkt.append(_reconnectProof);        // 16 bytes random
     pkt.append(VersionChallenge.data(), VersionChallenge.size());
-    socket().send((char const*)pkt.contents(), pkt.size());
-    return true;
+    SendPacket(pkt);
 }
 
 // Reconnect Proof command handler
@@ -788,8 +784,7 @@ bool AuthSocket::_HandleReconnectProof()
 #endif
     // Read the packet
     sAuthReconnectProof_C lp;
-    if (!socket().recv((char*)&lp, sizeof(sAuthReconnectProof_C)))
-        return false;
+    memcpy(&lp, GetReadBuffer().GetReadPointer(), sizeof(sAuthReconnectProof_C));
 
     _status = STATUS_CLOSED;
 
@@ -813,7 +808,7 @@ bool AuthSocket::_HandleReconnectProof()
         pkt << uint8(AUTH_RECONNECT_PROOF);
         pkt << uint8(0x00);
         pkt << uint16(0x00);                               // 2 bytes zeros
-        socket().send((char const*)pkt.contents(), pkt.size());
+        SendPacket(pkt);
 
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
@@ -823,8 +818,7 @@ bool AuthSocket::_HandleReconnectProof()
     else
     {
         LOG_ERROR("server.authserver.hack", "'%s:%d' [ERROR] user %s tried to login, but session is invalid.",
-            socket().getRemoteAddress().c_str(), socket().getRemotePort(), _accountInfo.Login.c_str());
-        socket().shutdown();
+            _ipAddress.c_str(), GetRemotePort(), _accountInfo.Login.c_str());
         return false;
     }
 }
@@ -859,38 +853,38 @@ bool AuthSocket::_HandleRealmList()
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     LOG_DEBUG("network", "Entering _HandleRealmList");
 #endif
-    if (socket().recv_len() < 5)
-        return false;
 
-    socket().recv_skip(5);
+    // the realm list is answered once the character counts of the account are loaded
+    // ordered after the session key update of the logon proof, the client connects to the world server once it has the list
+    _status = STATUS_CLOSED;
 
-    // Get the user id (else close the connection)
-    // No SQL injection (prepared statement)
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_ID_BY_NAME);
-    stmt->setString(0, _accountInfo.Login);
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALM_CHARACTER_COUNTS);
+    stmt->setUInt32(0, _accountInfo.Id);
 
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
-    if (!result)
+    AddQueryCallback(LoginDatabase.AsyncQuery(stmt, _accountInfo.Id), std::bind(&AuthSocket::RealmListCallback, shared_from_this(), std::placeholders::_1));
+    return true;
+}
+
+void AuthSocket::RealmListCallback(PreparedQueryResult result)
+{
+    std::map<uint32, uint8> characterCounts;
+    if (result)
     {
-        LOG_ERROR("server", "'%s:%d' [ERROR] user %s tried to login but we cannot find him in the database.", socket().getRemoteAddress().c_str(), socket().getRemotePort(), _accountInfo.Login.c_str());
-        socket().shutdown();
-        return false;
+        do
+        {
+            Field* fields = result->Fetch();
+            characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        } while (result->NextRow());
     }
 
-    Field* fields = result->Fetch();
-    uint32 id = fields[0].GetUInt32();
-
-    // Update realm list if need
-    sRealmList->UpdateIfNeed();
-
-    ACE_INET_Addr clientAddr;
-    socket().peer().get_remote_addr(clientAddr);
+    ACE_INET_Addr clientAddr(uint16(0), _ipAddress.c_str(), AF_INET);
 
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
     size_t RealmListSize = 0;
 
-    for (auto& [realmHandle, realm] : sRealmList->GetRealms())
+    RealmList::RealmMapSnapshot realms = sRealmList->GetRealms();
+    for (auto& [realmHandle, realm] : *realms)
     {
         // don't work with realms which not compatible with the client
         bool okBuild = ((_expversion & POST_BC_EXP_FLAG) && realm.Build == _build) || ((_expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.Build));
@@ -924,12 +918,9 @@ bool AuthSocket::_HandleRealmList()
         uint8 lock = (realm.AllowedSecurityLevel > _accountInfo.SecurityLevel) ? 1 : 0;
 
         uint8 AmountOfCharacters = 0;
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_NUM_CHARS_ON_REALM);
-        stmt->setUInt32(0, realm.Id.Realm);
-        stmt->setUInt32(1, id);
-        result = LoginDatabase.Query(stmt);
-        if (result)
-            AmountOfCharacters = (*result)[0].GetUInt8();
+        auto itr = characterCounts.find(realm.Id.Realm);
+        if (itr != characterCounts.end())
+            AmountOfCharacters = itr->second;
 
         pkt << realm.Type;                                  // realm type
         if (_expversion & POST_BC_EXP_FLAG)                 // only 2.x and 3.x clients
@@ -981,190 +972,7 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(RealmListSizeBuffer);                        // append RealmList's size buffer
     hdr.append(pkt);                                        // append realms in the realmlist
 
-    socket().send((char const*)hdr.contents(), hdr.size());
+    _status = STATUS_AUTHED;
 
-    return true;
-}
-
-// Resume patch transfer
-bool AuthSocket::_HandleXferResume()
-{
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "Entering _HandleXferResume");
-#endif
-    // Check packet length and patch existence
-    if (socket().recv_len() < 9 || !pPatch) // FIXME: pPatch is never used
-    {
-        LOG_ERROR("server", "Error while resuming patch transfer (wrong packet)");
-        return false;
-    }
-
-    // Launch a PatcherRunnable thread starting at given patch file offset
-    uint64 start;
-    socket().recv_skip(1);
-    socket().recv((char*)&start, sizeof(start));
-    fseek(pPatch, long(start), 0);
-
-    Acore::Thread u(new PatcherRunnable(this));
-    return true;
-}
-
-// Cancel patch transfer
-bool AuthSocket::_HandleXferCancel()
-{
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "Entering _HandleXferCancel");
-#endif
-
-    // Close and delete the socket
-    socket().recv_skip(1);                                         //clear input buffer
-    socket().shutdown();
-
-    return true;
-}
-
-// Accept patch transfer
-bool AuthSocket::_HandleXferAccept()
-{
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "Entering _HandleXferAccept");
-#endif
-
-    // Check packet length and patch existence
-    if (!pPatch)
-    {
-        LOG_ERROR("server", "Error while accepting patch transfer (wrong packet)");
-        return false;
-    }
-
-    // Launch a PatcherRunnable thread, starting at the beginning of the patch file
-    socket().recv_skip(1);                                         // clear input buffer
-    fseek(pPatch, 0, 0);
-
-    Acore::Thread u(new PatcherRunnable(this));
-    return true;
-}
-
-PatcherRunnable::PatcherRunnable(class AuthSocket* as)
-{
-    mySocket = as;
-}
-
-// Send content of patch file to the client
-void PatcherRunnable::run() { }
-
-// Preload MD5 hashes of existing patch files on server
-#ifndef _WIN32
-#include <cerrno>
-#include <dirent.h>
-void Patcher::LoadPatchesInfo()
-{
-    DIR* dirp;
-    struct dirent* dp;
-    dirp = opendir("./patches/");
-
-    if (!dirp)
-        return;
-
-    while (dirp)
-    {
-        errno = 0;
-        if ((dp = readdir(dirp)) != nullptr)
-        {
-            int l = strlen(dp->d_name);
-
-            if (l < 8)
-                continue;
-
-            if (!memcmp(&dp->d_name[l - 4], ".mpq", 4))
-                LoadPatchMD5(dp->d_name);
-        }
-        else
-        {
-            if (errno != 0)
-            {
-                closedir(dirp);
-                return;
-            }
-            break;
-        }
-    }
-
-    if (dirp)
-        closedir(dirp);
-}
-#else
-void Patcher::LoadPatchesInfo()
-{
-    WIN32_FIND_DATA fil;
-    HANDLE hFil = FindFirstFile("./patches/*.mpq", &fil);
-    if (hFil == INVALID_HANDLE_VALUE)
-        return;                                             // no patches were found
-
-    do
-        LoadPatchMD5(fil.cFileName);
-    while (FindNextFile(hFil, &fil));
-}
-#endif
-
-// Calculate and store MD5 hash for a given patch file
-void Patcher::LoadPatchMD5(char* szFileName)
-{
-    // Try to open the patch file
-    std::string path = "./patches/";
-    path += szFileName;
-    FILE* pPatch = fopen(path.c_str(), "rb");
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-    LOG_DEBUG("network", "Loading patch info from %s\n", path.c_str());
-#endif
-
-    if (!pPatch)
-    {
-        LOG_ERROR("server", "Error loading patch %s\n", path.c_str());
-        return;
-    }
-
-    // Calculate the MD5 hash
-    MD5_CTX ctx;
-    MD5_Init(&ctx);
-    uint8* buf = new uint8[512 * 1024];
-
-    while (!feof(pPatch))
-    {
-        size_t read = fread(buf, 1, 512 * 1024, pPatch);
-        MD5_Update(&ctx, buf, read);
-    }
-
-    delete [] buf;
-    fclose(pPatch);
-
-    // Store the result in the internal patch hash map
-    _patches[path] = new PATCH_INFO;
-    MD5_Final((uint8*)&_patches[path]->md5, &ctx);
-}
-
-// Get cached MD5 hash for a given patch file
-bool Patcher::GetHash(char* pat, uint8 mymd5[16])
-{
-    for (Patches::iterator i = _patches.begin(); i != _patches.end(); ++i)
-        if (!stricmp(pat, i->first.c_str()))
-        {
-            memcpy(mymd5, i->second->md5, 16);
-            return true;
-        }
-
-    return false;
-}
-
-// Launch the patch hashing mechanism on object creation
-Patcher::Patcher()
-{
-    LoadPatchesInfo();
-}
-
-// Empty and delete the patch map on termination
-Patcher::~Patcher()
-{
-    for (Patches::iterator i = _patches.begin(); i != _patches.end(); ++i)
-        delete i->second;
+    SendPacket(hdr);
 }
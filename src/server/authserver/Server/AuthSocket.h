@@ -9,12 +9,15 @@
 
 #include "Common.h"
 #include "CryptoHash.h"
+#include "DatabaseEnv.h"
 #include "Optional.h"
-#include "RealmSocket.h"
 #include "SRP6.h"
-#include <mutex>
+#include "Socket.h"
+#include <functional>
+#include <vector>
 
 class ACE_INET_Addr;
+class ByteBuffer;
 class Field;
 struct Realm;
 
@@ -44,17 +47,19 @@ struct AccountInfo
 };
 
 // Handle login commands
-class AuthSocket: public RealmSocket::Session
+// All handlers and query callbacks run on the network thread owning the socket,
+// database access is asynchronous so a slow query only delays the client waiting for it
+class AuthSocket : public Socket<AuthSocket>
 {
-public:
-    const static int s_BYTE_SIZE = 32;
+    typedef Socket<AuthSocket> AuthSocketBase;
+    typedef std::function<void(PreparedQueryResult)> QueryCallbackHandler;
 
-    AuthSocket(RealmSocket& socket);
+public:
+    AuthSocket(tcp::socket&& socket);
     ~AuthSocket() override;
 
-    void OnRead() override;
-    void OnAccept() override;
-    void OnClose() override;
+    void Start() override;
+    bool Update() override;
 
     static ACE_INET_Addr const& GetAddressForClient(Realm const& realm, ACE_INET_Addr const& clientAddr);
 
@@ -64,17 +69,21 @@ public:
     bool _HandleReconnectProof();
     bool _HandleRealmList();
 
-    //data transfer handle for patch
-    bool _HandleXferResume();
-    bool _HandleXferCancel();
-    bool _HandleXferAccept();
-
-    FILE* pPatch;
-    std::mutex patcherLock;
+protected:
+    void ReadHandler() override;
 
 private:
-    RealmSocket& socket_;
-    RealmSocket& socket() { return socket_; }
+    void LogonChallengeCallback(PreparedQueryResult result);
+    void LogonChallengeCountryCallback(PreparedQueryResult result);
+    void SendLogonChallengeResponse();
+    void ReconnectChallengeCallback(PreparedQueryResult result);
+    void RealmListCallback(PreparedQueryResult result);
+
+    void SendPacket(ByteBuffer& packet);
+    void SendLogonChallengeError(uint8 error);
+
+    void AddQueryCallback(PreparedQueryResultFuture future, QueryCallbackHandler&& handler);
+    void ProcessQueryCallbacks();
 
     std::optional<Acore::Crypto::SRP6> _srp6;
     SessionKey _sessionKey = {};
@@ -84,13 +93,18 @@ private:
 
     AccountInfo _accountInfo;
     Optional<std::vector<uint8>> _totpSecret;
+    Acore::Crypto::SRP6::Salt _salt = {};
+    Acore::Crypto::SRP6::Verifier _verifier = {};
 
     // Since GetLocaleByName() is _NOT_ bijective, we have to store the locale as a string. Otherwise we can't differ
     // between enUS and enGB, which is important for the patch system
     std::string _localizationName;
     std::string _os;
+    std::string _ipAddress;
     uint16 _build;
     uint8 _expversion;
+
+    std::vector<std::pair<PreparedQueryResultFuture, QueryCallbackHandler>> _queryCallbacks;
 };
 
 #endif
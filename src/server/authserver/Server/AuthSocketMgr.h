@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef AuthSocketMgr_h__
+#define AuthSocketMgr_h__
+
+#include "AuthSocket.h"
+#include "SocketMgr.h"
+
+/// Accepts the clients on the io context of the main thread and spreads them over the network threads
+class AuthSocketMgr : public SocketMgr<AuthSocket>
+{
+    typedef SocketMgr<AuthSocket> BaseSocketMgr;
+
+public:
+    static AuthSocketMgr* instance()
+    {
+        static AuthSocketMgr instance;
+        return &instance;
+    }
+
+    bool StartNetwork(Acore::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount) override
+    {
+        if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
+            return false;
+
+        _acceptor->AsyncAcceptWithCallback<&AuthSocketMgr::OnSocketAccept>();
+        return true;
+    }
+
+protected:
+    NetworkThread<AuthSocket>* CreateThreads() const override
+    {
+        return new NetworkThread<AuthSocket>[GetNetworkThreadCount()];
+    }
+
+    static void OnSocketAccept(tcp::socket&& sock, uint32 threadIndex)
+    {
+        instance()->OnSocketOpen(std::forward<tcp::socket>(sock), threadIndex);
+    }
+};
+
+#define sAuthSocketMgr AuthSocketMgr::instance()
+
+#endif // AuthSocketMgr_h__
@@ -70,6 +70,8 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
             }
         }
 
+        pool.SetBinaryQueries(sConfigMgr->GetOption<bool>(name + "Database.BinaryQueries", false, false));
+
         // Add the close operation
         _close.push([&pool]
         {
@@ -7,34 +7,35 @@
 #include "DatabaseEnv.h"
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
+#include "SQLOperationQueue.h"
 #include "MySQLConnection.h"
-#include "MySQLThreading.h"
 
-DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con) :
     m_queue(new_queue),
     m_conn(con)
 {
     /// Assign thread to task
-    activate();
+    m_workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
-int DatabaseWorker::svc()
+void DatabaseWorker::wait()
+{
+    if (m_workerThread.joinable())
+        m_workerThread.join();
+}
+
+void DatabaseWorker::WorkerThread()
 {
     if (!m_queue)
-        return -1;
+        return;
 
     SQLOperation* request = nullptr;
-    while (1)
+    while (m_queue->WaitAndPop(request))
     {
-        request = (SQLOperation*)(m_queue->dequeue());
-        if (!request)
-            break;
-
         request->SetConnection(m_conn);
         request->call();
 
         delete request;
+        m_queue->OnExecuted();
     }
-
-    return 0;
 }
@@ -7,24 +7,28 @@
 #ifndef _WORKERTHREAD_H
 #define _WORKERTHREAD_H
 
-#include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <thread>
 
 class MySQLConnection;
+class SQLOperationQueue;
 
-class DatabaseWorker : protected ACE_Task_Base
+class DatabaseWorker
 {
 public:
-    DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con);
+    DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con);
 
-    ///- Inherited from ACE_Task_Base
-    int svc() override;
-    int wait() override { return ACE_Task_Base::wait(); }
+    //! Blocks until the queue was closed and every queued operation executed.
+    void wait();
 
 private:
-    DatabaseWorker() : ACE_Task_Base() { }
-    ACE_Activation_Queue* m_queue;
+    void WorkerThread();
+
+    SQLOperationQueue* m_queue;
     MySQLConnection* m_conn;
+    std::thread m_workerThread;
+
+    DatabaseWorker(DatabaseWorker const& right) = delete;
+    DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
 };
 
 #endif
@@ -13,8 +13,6 @@
 #define MIN_MYSQL_CLIENT_VERSION 50700u
 
 template <class T> DatabaseWorkerPool<T>::DatabaseWorkerPool() :
-    _mqueue(new ACE_Message_Queue<ACE_SYNCH>(2 * 1024 * 1024, 2 * 1024 * 1024)),
-    _queue(new ACE_Activation_Queue(_mqueue)),
     _async_threads(0),
     _synch_threads(0)
 {
@@ -68,10 +66,11 @@ void DatabaseWorkerPool<T>::Close()
 {
     LOG_INFO("sql.driver", "Closing down DatabasePool '%s'.", GetDatabaseName());
 
-    //! Shuts down delaythreads for this connection pool by underlying deactivate().
-    //! The next dequeue attempt in the worker thread tasks will result in an error,
+    //! Shuts down delaythreads for this connection pool.
+    //! Workers execute what is still queued, then their dequeue attempt fails,
     //! ultimately ending the worker thread task.
-    _queue->queue()->close();
+    for (std::unique_ptr<SQLOperationQueue>& queue : _queues)
+        queue->Close();
 
     for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
     {
@@ -92,13 +91,18 @@ void DatabaseWorkerPool<T>::Close()
     for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
         _connections[IDX_SYNCH][i]->Close();
 
-    //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
-    delete _queue;
-    delete _mqueue;
+    _queues.clear();
 
     LOG_INFO("sql.driver", "All connections on DatabasePool '%s' closed.", GetDatabaseName());
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetBinaryQueries(bool enable)
+{
+    for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
+        _connections[IDX_SYNCH][i]->SetBinaryQueries(enable);
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConnections)
 {
@@ -109,7 +113,8 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
 
         if (type == IDX_ASYNC)
         {
-            t = new T(_queue, *_connectionInfo);
+            _queues.push_back(std::make_unique<SQLOperationQueue>());
+            t = new T(_queues.back().get(), *_connectionInfo);
         }
         else if (type == IDX_SYNCH)
         {
@@ -195,10 +200,10 @@ void DatabaseWorkerPool<T>::Execute(const char* sql)
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement* stmt, uint32 orderKey /*= 0*/)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, orderKey);
 }
 
 template <class T>
@@ -270,20 +275,20 @@ QueryResultFuture DatabaseWorkerPool<T>::AsyncQuery(const char* sql)
 }
 
 template <class T>
-PreparedQueryResultFuture DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement* stmt)
+PreparedQueryResultFuture DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement* stmt, uint32 orderKey /*= 0*/)
 {
     PreparedQueryResultFuture res;
     PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
-    Enqueue(task);
+    Enqueue(task, orderKey);
     return res;
 }
 
 template <class T>
-QueryResultHolderFuture DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder* holder)
+QueryResultHolderFuture DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder* holder, uint32 orderKey /*= 0*/)
 {
     QueryResultHolderFuture res;
     SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-    Enqueue(task);
+    Enqueue(task, orderKey);
     return res;     //! Fool compiler, has no use yet
 }
 
@@ -294,7 +299,7 @@ SQLTransaction DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction transaction, uint32 orderKey /*= 0*/)
 {
 #ifdef ACORE_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -313,7 +318,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction transaction)
     }
 #endif // ACORE_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), orderKey);
 }
 
 template <class T>
@@ -383,11 +388,51 @@ void DatabaseWorkerPool<T>::KeepAlive()
         }
     }
 
-    //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-    //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-    //! as the sole purpose is to prevent connections from idling.
-    for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
-        Enqueue(new PingOperation);
+    //! Every async connection has its own queue, so each one receives exactly 1 ping operation request
+    for (std::unique_ptr<SQLOperationQueue>& queue : _queues)
+        queue->Push(new PingOperation);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, uint32 orderKey /*= 0*/)
+{
+    ASSERT(!_queues.empty(), "DatabasePool '%s' has no asynchronous connections", GetDatabaseName());
+
+    if (orderKey)
+    {
+        _queues[orderKey % _queues.size()]->Push(op);
+        return;
+    }
+
+    //! Unordered operations go to the connection with the least queued work, an idle one if possible
+    SQLOperationQueue* target = _queues.front().get();
+    for (std::unique_ptr<SQLOperationQueue>& queue : _queues)
+    {
+        if (queue->GetSize() < target->GetSize())
+            target = queue.get();
+
+        if (!target->GetSize())
+            break;
+    }
+
+    target->Push(op);
+}
+
+template <class T>
+SQLOperationQueueStats DatabaseWorkerPool<T>::GetQueueStats() const
+{
+    SQLOperationQueueStats stats;
+    for (std::unique_ptr<SQLOperationQueue> const& queue : _queues)
+        queue->FillStats(stats);
+
+    return stats;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ResetQueueStats()
+{
+    for (std::unique_ptr<SQLOperationQueue>& queue : _queues)
+        queue->ResetStats();
 }
 
 template <class T>
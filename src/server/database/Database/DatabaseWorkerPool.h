@@ -17,7 +17,9 @@
 #include "QueryResult.h"
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
+#include "SQLOperationQueue.h"
 #include "StringFormat.h"
+#include <memory>
 #include <mutex>
 
 class PingOperation : public SQLOperation
@@ -42,6 +44,9 @@ public:
     uint32 Open();
     void Close();
 
+    //! Sends ad hoc queries of the synchronous connections as prepared statements, see MySQLConnection::SetBinaryQueries.
+    void SetBinaryQueries(bool enable);
+
     //! Prepares all prepared statements
     bool PrepareStatements();
 
@@ -71,7 +76,8 @@ public:
 
     //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
     //! Statement must be prepared with CONNECTION_ASYNC flag.
-    void Execute(PreparedStatement* stmt);
+    //! Operations enqueued with the same non zero orderKey (e.g. a character guid) are executed in order.
+    void Execute(PreparedStatement* stmt, uint32 orderKey = 0);
 
     /**
         Direct synchronous one-way statement methods.
@@ -153,13 +159,15 @@ public:
     //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
     //! The return value is then processed in ProcessQueryCallback methods.
     //! Statement must be prepared with CONNECTION_ASYNC flag.
-    PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt);
+    //! With a non zero orderKey the query runs after the operations enqueued before with the same key.
+    PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, uint32 orderKey = 0);
 
     //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
     //! return object as soon as the query is executed.
     //! The return value is then processed in ProcessQueryCallback methods.
     //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-    QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder);
+    //! Operations enqueued with the same non zero orderKey (e.g. a character guid) are executed in order.
+    QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, uint32 orderKey = 0);
 
     /**
         Transaction context methods.
@@ -170,7 +178,9 @@ public:
 
     //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
     //! were appended to the transaction will be respected during execution.
-    void CommitTransaction(SQLTransaction transaction);
+    //! Operations enqueued with the same non zero orderKey (e.g. a character guid) are executed in order,
+    //! operations without a key go to the least busy connection.
+    void CommitTransaction(SQLTransaction transaction, uint32 orderKey = 0);
 
     //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
     //! were appended to the transaction will be respected during execution.
@@ -205,6 +215,10 @@ public:
     //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
     void KeepAlive();
 
+    //! Sums the statistics of the asynchronous connection queues.
+    SQLOperationQueueStats GetQueueStats() const;
+    void ResetQueueStats();
+
     void EscapeString(std::string& str)
     {
         if (str.empty())
@@ -226,10 +240,8 @@ private:
 
     uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
-    void Enqueue(SQLOperation* op)
-    {
-        _queue->enqueue(op);
-    }
+    //! Operations with the same key always go to the same connection queue, which keeps them ordered.
+    void Enqueue(SQLOperation* op, uint32 orderKey = 0);
 
     [[nodiscard]] char const* GetDatabaseName() const;
 
@@ -237,8 +249,7 @@ private:
     //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
     T* GetFreeConnection();
 
-    ACE_Message_Queue<ACE_SYNCH>* _mqueue;
-    ACE_Activation_Queue* _queue; //! Queue shared by async worker threads.
+    std::vector<std::unique_ptr<SQLOperationQueue>> _queues; //! One queue per async connection.
     std::vector<std::vector<T*>> _connections;
     uint32 _connectionCount[IDX_SIZE]; //! Counter of MySQL connections;
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
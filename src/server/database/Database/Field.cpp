@@ -13,43 +13,28 @@ Field::Field()
     data.type = MYSQL_TYPE_NULL;
     data.length = 0;
     data.raw = false;
+    data.isUnsigned = false;
 }
 
 Field::~Field()
 {
-    CleanUp();
 }
 
-void Field::SetByteValue(const void* newValue, const size_t newSize, enum_field_types newType, uint32 length)
+void Field::SetByteValue(void const* newValue, enum_field_types newType, uint32 length, bool isUnsigned)
 {
-    if (data.value)
-        CleanUp();
-
     // This value stores raw bytes that have to be explicitly cast later
-    if (newValue)
-    {
-        data.value = new char[newSize];
-        memcpy(data.value, newValue, newSize);
-        data.length = length;
-    }
+    data.value = const_cast<void*>(newValue);
+    data.length = newValue ? length : 0;
     data.type = newType;
     data.raw = true;
+    data.isUnsigned = isUnsigned;
 }
 
-void Field::SetStructuredValue(char* newValue, enum_field_types newType, uint32 length)
+void Field::SetStructuredValue(char const* newValue, enum_field_types newType, uint32 length)
 {
-    if (data.value)
-        CleanUp();
-
     // This value stores somewhat structured data that needs function style casting
-    if (newValue)
-    {
-        data.value = new char[length + 1];
-        memcpy(data.value, newValue, length);
-        *(reinterpret_cast<char*>(data.value) + length) = '\0';
-        data.length = length;
-    }
-
+    data.value = const_cast<char*>(newValue);
+    data.length = newValue ? length : 0;
     data.type = newType;
     data.raw = false;
 }
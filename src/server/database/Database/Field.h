@@ -10,7 +10,10 @@
 #include "Common.h"
 #include "Log.h"
 #include <array>
+#include <charconv>
 #include <mysql.h>
+#include <string_view>
+#include <type_traits>
 
 class Field
 {
@@ -36,9 +39,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && IsType(MYSQL_TYPE_TINY))
             return *reinterpret_cast<uint8*>(data.value);
-        return static_cast<uint8>(atol((char*)data.value));
+        return GetConvertedValue<uint8>();
     }
 
     [[nodiscard]] int8 GetInt8() const
@@ -54,9 +57,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && IsType(MYSQL_TYPE_TINY))
             return *reinterpret_cast<int8*>(data.value);
-        return static_cast<int8>(atol((char*)data.value));
+        return GetConvertedValue<int8>();
     }
 
 #ifdef ELUNA
@@ -79,9 +82,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_SHORT) || IsType(MYSQL_TYPE_YEAR)))
             return *reinterpret_cast<uint16*>(data.value);
-        return static_cast<uint16>(atol((char*)data.value));
+        return GetConvertedValue<uint16>();
     }
 
     [[nodiscard]] int16 GetInt16() const
@@ -97,9 +100,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_SHORT) || IsType(MYSQL_TYPE_YEAR)))
             return *reinterpret_cast<int16*>(data.value);
-        return static_cast<int16>(atol((char*)data.value));
+        return GetConvertedValue<int16>();
     }
 
     [[nodiscard]] uint32 GetUInt32() const
@@ -115,9 +118,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_INT24) || IsType(MYSQL_TYPE_LONG)))
             return *reinterpret_cast<uint32*>(data.value);
-        return static_cast<uint32>(atol((char*)data.value));
+        return GetConvertedValue<uint32>();
     }
 
     [[nodiscard]] int32 GetInt32() const
@@ -133,9 +136,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_INT24) || IsType(MYSQL_TYPE_LONG)))
             return *reinterpret_cast<int32*>(data.value);
-        return static_cast<int32>(atol((char*)data.value));
+        return GetConvertedValue<int32>();
     }
 
     [[nodiscard]] uint64 GetUInt64() const
@@ -151,9 +154,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_LONGLONG) || IsType(MYSQL_TYPE_BIT)))
             return *reinterpret_cast<uint64*>(data.value);
-        return static_cast<uint64>(atol((char*)data.value));
+        return GetConvertedValue<uint64>();
     }
 
     [[nodiscard]] int64 GetInt64() const
@@ -169,9 +172,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && (IsType(MYSQL_TYPE_LONGLONG) || IsType(MYSQL_TYPE_BIT)))
             return *reinterpret_cast<int64*>(data.value);
-        return static_cast<int64>(strtol((char*)data.value, nullptr, 10));
+        return GetConvertedValue<int64>();
     }
 
     [[nodiscard]] float GetFloat() const
@@ -187,9 +190,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && IsType(MYSQL_TYPE_FLOAT))
             return *reinterpret_cast<float*>(data.value);
-        return static_cast<float>(atof((char*)data.value));
+        return GetConvertedValue<float>();
     }
 
     [[nodiscard]] double GetDouble() const
@@ -205,9 +208,9 @@ public:
         }
 #endif
 
-        if (data.raw)
+        if (data.raw && IsType(MYSQL_TYPE_DOUBLE))
             return *reinterpret_cast<double*>(data.value);
-        return static_cast<double>(atof((char*)data.value));
+        return GetConvertedValue<double>();
     }
 
     [[nodiscard]] char const* GetCString() const
@@ -240,6 +243,15 @@ public:
         return std::string((char*)data.value);
     }
 
+    // points into the result set: valid until NextRow() for QueryResult, as long as the result for PreparedQueryResult
+    [[nodiscard]] std::string_view GetStringView() const
+    {
+        if (!data.value)
+            return std::string_view();
+
+        return std::string_view(static_cast<char const*>(data.value), data.length);
+    }
+
     [[nodiscard]] bool IsNull() const
     {
         if (IsBinary() && data.length == 0)
@@ -270,9 +282,10 @@ protected:
     struct
     {
         uint32 length;          // Length (prepared strings only)
-        void* value;            // Actual data in memory
+        void* value;            // Actual data in memory, owned by the result set
         enum_field_types type;  // Field type
         bool raw;               // Raw bytes? (Prepared statement or ad hoc)
+        bool isUnsigned;        // Raw integer is unsigned
     } data;
 #if defined(__GNUC__)
 #pragma pack()
@@ -280,14 +293,8 @@ protected:
 #pragma pack(pop)
 #endif
 
-    void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
-    void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
-
-    void CleanUp()
-    {
-        delete[] ((char*)data.value);
-        data.value = nullptr;
-    }
+    void SetByteValue(void const* newValue, enum_field_types newType, uint32 length, bool isUnsigned);
+    void SetStructuredValue(char const* newValue, enum_field_types newType, uint32 length);
 
     static size_t SizeForType(MYSQL_FIELD* field)
     {
@@ -369,6 +376,84 @@ protected:
 
     void GetBinarySizeChecked(uint8* buf, size_t size) const;
 
+    // reads a value that is text or was sent with another type than the getter asks for
+    template<typename T>
+    [[nodiscard]] T GetConvertedValue() const
+    {
+        if (!data.raw)
+            return ParseValue<T>();
+
+        switch (data.type)
+        {
+            case MYSQL_TYPE_TINY:
+                return data.isUnsigned ? CastValue<T>(*reinterpret_cast<uint8*>(data.value)) : CastValue<T>(*reinterpret_cast<int8*>(data.value));
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_YEAR:
+                return data.isUnsigned ? CastValue<T>(*reinterpret_cast<uint16*>(data.value)) : CastValue<T>(*reinterpret_cast<int16*>(data.value));
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+                return data.isUnsigned ? CastValue<T>(*reinterpret_cast<uint32*>(data.value)) : CastValue<T>(*reinterpret_cast<int32*>(data.value));
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_BIT:
+                return data.isUnsigned ? CastValue<T>(*reinterpret_cast<uint64*>(data.value)) : CastValue<T>(*reinterpret_cast<int64*>(data.value));
+            case MYSQL_TYPE_FLOAT:
+                return CastValue<T>(*reinterpret_cast<float*>(data.value));
+            case MYSQL_TYPE_DOUBLE:
+                return CastValue<T>(*reinterpret_cast<double*>(data.value));
+            case MYSQL_TYPE_DECIMAL:
+            case MYSQL_TYPE_NEWDECIMAL:
+                return ParseValue<T>();
+            default:
+                return IsBinary() ? ParseValue<T>() : T(0);
+        }
+    }
+
+    // integers wrap like the atol() casts did, fractions are cut off
+    template<typename T, typename V>
+    [[nodiscard]] static T CastValue(V value)
+    {
+        if constexpr (std::is_integral_v<T> && std::is_floating_point_v<V>)
+            return static_cast<T>(static_cast<int64>(value));
+        else
+            return static_cast<T>(value);
+    }
+
+    template<typename T>
+    [[nodiscard]] T ParseValue() const
+    {
+        char const* begin = static_cast<char const*>(data.value);
+        char const* end = begin + data.length;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+#ifdef __cpp_lib_to_chars
+            T value = T(0);
+            std::from_chars(begin, end, value);
+            return value;
+#else
+            return static_cast<T>(atof(begin));
+#endif
+        }
+        else
+        {
+            // parsed with 64 bits and then cast, so negative values read as unsigned wrap like with atol()
+            int64 value = 0;
+            std::from_chars_result result = std::from_chars(begin, end, value);
+            if (result.ec == std::errc::result_out_of_range)
+            {
+                uint64 unsignedValue = 0;
+                std::from_chars(begin, end, unsignedValue);
+                return static_cast<T>(unsignedValue);
+            }
+
+            // decimal values in integer getters
+            if (result.ptr != end && *result.ptr == '.')
+                return CastValue<T>(ParseValue<double>());
+
+            return static_cast<T>(value);
+        }
+    }
+
 private:
 #ifdef ACORE_DEBUG
     static char const* FieldTypeToString(enum_field_types type)
@@ -15,7 +15,7 @@ class CharacterDatabaseConnection : public MySQLConnection
 public:
     //- Constructors for sync and async connections
     CharacterDatabaseConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) {}
-    CharacterDatabaseConnection(ACE_Activation_Queue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) {}
+    CharacterDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) {}
 
     //- Loads database type specific prepared statements
     void DoPrepareStatements() override;
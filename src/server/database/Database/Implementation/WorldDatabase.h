@@ -15,7 +15,7 @@ class WorldDatabaseConnection : public MySQLConnection
 public:
     //- Constructors for sync and async connections
     WorldDatabaseConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) { }
-    WorldDatabaseConnection(ACE_Activation_Queue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) { }
+    WorldDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) { }
 
     //- Loads database type specific prepared statements
     void DoPrepareStatements() override;
@@ -30,17 +30,19 @@ MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
     m_worker(nullptr),
     m_Mysql(nullptr),
     m_connectionInfo(connInfo),
-    m_connectionFlags(CONNECTION_SYNCH)
+    m_connectionFlags(CONNECTION_SYNCH),
+    m_binaryQueries(false)
 {
 }
 
-MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
     m_prepareError(false),
     m_queue(queue),
     m_Mysql(nullptr),
     m_connectionInfo(connInfo),
-    m_connectionFlags(CONNECTION_ASYNC)
+    m_connectionFlags(CONNECTION_ASYNC),
+    m_binaryQueries(false)
 {
     m_worker = new DatabaseWorker(m_queue, this);
 }
@@ -288,6 +290,10 @@ ResultSet* MySQLConnection::Query(const char* sql)
     if (!sql)
         return nullptr;
 
+    ResultSet* binaryResult = nullptr;
+    if (m_binaryQueries && BinaryQuery(sql, binaryResult))
+        return binaryResult;
+
     MYSQL_RES* result = nullptr;
     MYSQL_FIELD* fields = nullptr;
     uint64 rowCount = 0;
@@ -299,6 +305,57 @@ ResultSet* MySQLConnection::Query(const char* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
+bool MySQLConnection::BinaryQuery(const char* sql, ResultSet*& result)
+{
+    //! Statements the server can not prepare, or that have parameter markers, return false and take the text path
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+        return false;
+
+    if (mysql_stmt_prepare(stmt, sql, static_cast<unsigned long>(strlen(sql))) || mysql_stmt_param_count(stmt))
+    {
+        mysql_stmt_close(stmt);
+        return false;
+    }
+
+    uint32 _s = getMSTime();
+
+    if (mysql_stmt_execute(stmt))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(b): %s\n [ERROR]: [%u] %s", sql, lErrno, mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+
+        if (_HandleMySQLErrno(lErrno))          // If it returns true, an error was handled successfully (i.e. reconnection)
+            return BinaryQuery(sql, result);    // Try again
+
+        return true;
+    }
+
+    LOG_DEBUG("sql.sql", "[%u ms] SQL(b): %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+    //! Statements without a result set are done
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (!metadata)
+    {
+        mysql_stmt_close(stmt);
+        return true;
+    }
+
+    PreparedResultSet* preparedResult = new PreparedResultSet(stmt, metadata, 0, mysql_stmt_field_count(stmt));
+
+    //! The result set leaves its length and null arrays bound to the statement, see ~MySQLPreparedStatement
+    if (stmt->bind_result_done)
+    {
+        delete[] stmt->bind->length;
+        delete[] stmt->bind->is_null;
+    }
+
+    mysql_stmt_close(stmt);
+    result = new ResultSet(preparedResult);
+    return true;
+}
+
 bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
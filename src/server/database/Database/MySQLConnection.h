@@ -4,8 +4,6 @@
  * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
  */
 
-#include <ace/Activation_Queue.h>
-
 #include "DatabaseWorkerPool.h"
 #include "Transaction.h"
 #include "Util.h"
@@ -15,6 +13,7 @@
 
 class DatabaseWorker;
 class PreparedStatement;
+class SQLOperationQueue;
 class MySQLPreparedStatement;
 class PingOperation;
 
@@ -60,7 +59,7 @@ class MySQLConnection
 
 public:
     MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-    MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+    MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo);     //! Constructor for asynchronous connections.
     virtual ~MySQLConnection();
 
     virtual uint32 Open();
@@ -85,6 +84,9 @@ public:
 
     uint32 GetLastError() { return mysql_errno(m_Mysql); }
 
+    //! Sends ad hoc queries as server side prepared statements, the values arrive in binary form instead of text.
+    void SetBinaryQueries(bool enable) { m_binaryQueries = enable; }
+
 protected:
     bool LockIfReady()
     {
@@ -113,13 +115,15 @@ protected:
 
 private:
     bool _HandleMySQLErrno(uint32 errNo);
+    bool BinaryQuery(const char* sql, ResultSet*& result);
 
 private:
-    ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
+    SQLOperationQueue*    m_queue;                      //! Queue of operations executed by this connection.
     DatabaseWorker*       m_worker;                     //! Core worker task.
     MYSQL*                m_Mysql;                      //! MySQL Handle.
     MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
     ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
+    bool                  m_binaryQueries;              //! Are ad hoc queries prepared?
     std::mutex            m_Mutex;
 
     MySQLConnection(MySQLConnection const& right) = delete;
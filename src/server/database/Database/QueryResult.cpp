@@ -6,17 +6,52 @@
 
 #include "DatabaseEnv.h"
 #include "Log.h"
+#include <algorithm>
+#include <new>
 
 ResultSet::ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
     _rowCount(rowCount),
     _fieldCount(fieldCount),
     _result(result),
-    _fields(fields)
+    _fields(fields),
+    _preparedResult(nullptr)
 {
     _currentRow = new Field[_fieldCount];
     ASSERT(_currentRow);
 }
 
+ResultSet::ResultSet(PreparedResultSet* result) :
+    _rowCount(result->GetRowCount()),
+    _currentRow(nullptr),
+    _fieldCount(result->GetFieldCount()),
+    _result(nullptr),
+    _fields(nullptr),
+    _preparedResult(result)
+{
+}
+
+// bind buffer of the variable length columns, longer values are fetched with mysql_stmt_fetch_column
+static constexpr size_t VARIABLE_LENGTH_BIND_SIZE = 256;
+// the arena grows from the first to the last block size, so small results stay small
+static constexpr size_t ARENA_FIRST_BLOCK_SIZE = 4 * 1024;
+static constexpr size_t ARENA_LAST_BLOCK_SIZE = 1024 * 1024;
+
+static bool IsVariableLengthType(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64 rowCount, uint32 fieldCount) :
     m_rowCount(rowCount),
     m_rowPosition(0),
@@ -25,7 +60,9 @@ PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64
     m_stmt(stmt),
     m_res(result),
     m_isNull(nullptr),
-    m_length(nullptr)
+    m_length(nullptr),
+    m_arenaPosition(nullptr),
+    m_arenaLeft(0)
 {
     if (!m_res)
         return;
@@ -44,22 +81,12 @@ PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64
     memset(m_rBind, 0, sizeof(MYSQL_BIND) * m_fieldCount);
     memset(m_length, 0, sizeof(unsigned long) * m_fieldCount);
 
-    //- This is where we store the (entire) resultset
-    if (mysql_stmt_store_result(m_stmt))
-    {
-        LOG_INFO("sql.driver", "%s:mysql_stmt_store_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
-        delete[] m_rBind;
-        delete[] m_isNull;
-        delete[] m_length;
-        return;
-    }
-
     //- This is where we prepare the buffer based on metadata
     uint32 i = 0;
     MYSQL_FIELD* field = mysql_fetch_field(m_res);
     while (field)
     {
-        size_t size = Field::SizeForType(field);
+        size_t size = IsVariableLengthType(field->type) ? VARIABLE_LENGTH_BIND_SIZE : Field::SizeForType(field);
 
         m_rBind[i].buffer_type = field->type;
         m_rBind[i].buffer = malloc(size);
@@ -84,46 +111,105 @@ PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64
         return;
     }
 
-    m_rowCount = mysql_stmt_num_rows(m_stmt);
+    //- The rows are not stored by the client library first, every row is fetched from the server
+    //- straight into the arena, so the result set is only held in memory once
+    int status;
+    bool failed = false;
+    while ((status = mysql_stmt_fetch(m_stmt)) == 0 || status == MYSQL_DATA_TRUNCATED)
+    {
+        if (!StoreRow())
+        {
+            failed = true;
+            break;
+        }
+    }
+
+    if (status == 1)
+    {
+        LOG_ERROR("sql.driver", "%s:mysql_stmt_fetch, cannot fetch result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        failed = true;
+    }
+
+    // a truncated result would look complete to the loaders, they get no rows instead
+    if (failed)
+        m_rows.clear();
 
-    m_rows.resize(uint32(m_rowCount));
-    while (_NextRow())
+    m_rowCount = m_rows.size();
+
+    /// All data is buffered, let go of mysql c api structures
+    CleanUp();
+}
+
+void* PreparedResultSet::Allocate(size_t size)
+{
+    // keeps every value 8 byte aligned for the reinterpret_casts in Field
+    size = (size + 7) & ~size_t(7);
+
+    if (size > m_arenaLeft)
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        size_t blockSize = std::min(ARENA_FIRST_BLOCK_SIZE << std::min<size_t>(m_arenaBlocks.size(), 8), ARENA_LAST_BLOCK_SIZE);
+
+        // large blobs get a block of their own, the current block is still filled
+        if (size > blockSize / 4)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                        m_rBind[fIndex].buffer_length,
-                        m_rBind[fIndex].buffer_type,
-                        *m_rBind[fIndex].length );
-            else
-                switch (m_rBind[fIndex].buffer_type)
+            char* block = new char[size];
+            m_arenaBlocks.push_back(block);
+            return block;
+        }
+
+        m_arenaPosition = new char[blockSize];
+        m_arenaLeft = blockSize;
+        m_arenaBlocks.push_back(m_arenaPosition);
+    }
+
+    void* memory = m_arenaPosition;
+    m_arenaPosition += size;
+    m_arenaLeft -= size;
+    return memory;
+}
+
+bool PreparedResultSet::StoreRow()
+{
+    Field* row = static_cast<Field*>(Allocate(sizeof(Field) * m_fieldCount));
+    for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+    {
+        Field* field = new (&row[fIndex]) Field();
+        MYSQL_BIND& bind = m_rBind[fIndex];
+
+        if (IsVariableLengthType(bind.buffer_type))
+        {
+            // null strings and blobs are stored as empty values, IsNull() checks their length
+            unsigned long length = m_isNull[fIndex] ? 0 : m_length[fIndex];
+            char* value = static_cast<char*>(Allocate(length + 1));
+            if (length > bind.buffer_length)
+            {
+                MYSQL_BIND column = bind;
+                column.buffer = value;
+                column.buffer_length = length;
+                if (mysql_stmt_fetch_column(m_stmt, &column, fIndex, 0))
                 {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                m_rBind[fIndex].buffer_length,
-                                m_rBind[fIndex].buffer_type,
-                                *m_rBind[fIndex].length );
-                        break;
-                    default:
-                        m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                m_rBind[fIndex].buffer_length,
-                                m_rBind[fIndex].buffer_type,
-                                *m_rBind[fIndex].length );
+                    LOG_ERROR("sql.driver", "%s:mysql_stmt_fetch_column, cannot fetch column %u from MySQL server. Error: %s", __FUNCTION__, fIndex, mysql_stmt_error(m_stmt));
+                    return false;
                 }
+            }
+            else if (length)
+                memcpy(value, bind.buffer, length);
+
+            value[length] = '\0';
+            field->SetByteValue(value, bind.buffer_type, uint32(length), bind.is_unsigned);
         }
-        m_rowPosition++;
+        else if (!m_isNull[fIndex])
+        {
+            void* value = Allocate(bind.buffer_length);
+            memcpy(value, bind.buffer, bind.buffer_length);
+            field->SetByteValue(value, bind.buffer_type, uint32(m_length[fIndex]), bind.is_unsigned);
+        }
+        else
+            field->SetByteValue(nullptr, bind.buffer_type, 0, bind.is_unsigned);
     }
-    m_rowPosition = 0;
 
-    /// All data is buffered, let go of mysql c api structures
-    CleanUp();
+    m_rows.push_back(row);
+    return true;
 }
 
 ResultSet::~ResultSet()
@@ -133,12 +219,29 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    // Field does not own its value, the rows only need their memory back
+    for (char* block : m_arenaBlocks)
+        delete[] block;
 }
 
 bool ResultSet::NextRow()
 {
+    if (_preparedResult)
+    {
+        // the first call selects the first row, like mysql_fetch_row would
+        if (_currentRow && !_preparedResult->NextRow())
+        {
+            CleanUp();
+            return false;
+        }
+
+        _currentRow = _preparedResult->GetRowCount() ? _preparedResult->Fetch() : nullptr;
+        if (!_currentRow)
+            CleanUp();
+
+        return _currentRow != nullptr;
+    }
+
     MYSQL_ROW row;
 
     if (!_result)
@@ -174,24 +277,6 @@ bool PreparedResultSet::NextRow()
     return true;
 }
 
-bool PreparedResultSet::_NextRow()
-{
-    /// Only called in low-level code, namely the constructor
-    /// Will iterate over every row of data and buffer it
-    if (m_rowPosition >= m_rowCount)
-        return false;
-
-    int retval = mysql_stmt_fetch( m_stmt );
-
-    if (!retval || retval == MYSQL_DATA_TRUNCATED)
-        retval = true;
-
-    if (retval == MYSQL_NO_DATA)
-        retval = false;
-
-    return retval;
-}
-
 #ifdef ELUNA
 std::string ResultSet::GetFieldName(uint32 index) const
 {
@@ -202,6 +287,14 @@ std::string ResultSet::GetFieldName(uint32 index) const
 
 void ResultSet::CleanUp()
 {
+    if (_preparedResult)
+    {
+        // the rows belong to the prepared result
+        delete _preparedResult;
+        _preparedResult = nullptr;
+        _currentRow = nullptr;
+    }
+
     if (_currentRow)
     {
         delete [] _currentRow;
@@ -20,10 +20,13 @@
 typedef bool my_bool;
 #endif
 
+class PreparedResultSet;
+
 class ResultSet
 {
 public:
     ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+    explicit ResultSet(PreparedResultSet* result); // rows of an ad hoc query sent as prepared statement
     ~ResultSet();
 
     bool NextRow();
@@ -48,6 +51,7 @@ private:
     void CleanUp();
     MYSQL_RES* _result;
     MYSQL_FIELD* _fields;
+    PreparedResultSet* _preparedResult;
 };
 
 typedef std::shared_ptr<ResultSet> QueryResult;
@@ -89,9 +93,15 @@ private:
     my_bool* m_isNull;
     unsigned long* m_length;
 
+    // rows, their fields and all values are allocated one after another from large blocks
+    std::vector<char*> m_arenaBlocks;
+    char* m_arenaPosition;
+    size_t m_arenaLeft;
+
+    void* Allocate(size_t size);
+    bool StoreRow();
     void FreeBindBuffer();
     void CleanUp();
-    bool _NextRow();
 };
 
 typedef std::shared_ptr<PreparedResultSet> PreparedQueryResult;
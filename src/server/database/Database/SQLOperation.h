@@ -7,10 +7,8 @@
 #ifndef _SQLOPERATION_H
 #define _SQLOPERATION_H
 
-#include <ace/Method_Request.h>
-#include <ace/Activation_Queue.h>
-
 #include "QueryResult.h"
+#include <chrono>
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -45,11 +43,13 @@ union SQLResultSetUnion
 
 class MySQLConnection;
 
-class SQLOperation : public ACE_Method_Request
+class SQLOperation
 {
 public:
     SQLOperation(): m_conn(nullptr) { }
-    int call() override
+    virtual ~SQLOperation() = default;
+
+    int call()
     {
         Execute();
         return 0;
@@ -58,6 +58,9 @@ public:
     virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
     MySQLConnection* m_conn;
+
+    //! Set by SQLOperationQueue when the operation is queued, used for the queue latency statistics.
+    std::chrono::steady_clock::time_point m_queuedTime;
 };
 
 #endif
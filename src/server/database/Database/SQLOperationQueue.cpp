@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "SQLOperationQueue.h"
+#include "SQLOperation.h"
+#include <algorithm>
+
+SQLOperationQueue::SQLOperationQueue() :
+    _closed(false), _size(0), _peakSize(0), _executed(0), _totalWaitUs(0), _maxWaitUs(0) { }
+
+SQLOperationQueue::~SQLOperationQueue()
+{
+    for (SQLOperation* op : _queue)
+        delete op;
+}
+
+void SQLOperationQueue::Push(SQLOperation* op)
+{
+    op->m_queuedTime = std::chrono::steady_clock::now();
+
+    uint64 size = _size.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64 peak = _peakSize.load(std::memory_order_relaxed);
+    while (size > peak && !_peakSize.compare_exchange_weak(peak, size, std::memory_order_relaxed));
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _queue.push_back(op);
+    }
+
+    _cond.notify_one();
+}
+
+bool SQLOperationQueue::WaitAndPop(SQLOperation*& op)
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    _cond.wait(guard, [this] { return !_queue.empty() || _closed; });
+
+    if (_queue.empty())
+        return false;
+
+    op = _queue.front();
+    _queue.pop_front();
+    guard.unlock();
+
+    uint64 waitUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - op->m_queuedTime).count();
+    _totalWaitUs.fetch_add(waitUs, std::memory_order_relaxed);
+
+    uint64 maxWait = _maxWaitUs.load(std::memory_order_relaxed);
+    while (waitUs > maxWait && !_maxWaitUs.compare_exchange_weak(maxWait, waitUs, std::memory_order_relaxed));
+
+    return true;
+}
+
+void SQLOperationQueue::OnExecuted()
+{
+    _executed.fetch_add(1, std::memory_order_relaxed);
+    _size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SQLOperationQueue::Close()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _closed = true;
+    }
+
+    _cond.notify_all();
+}
+
+void SQLOperationQueue::FillStats(SQLOperationQueueStats& stats) const
+{
+    stats.Size += _size.load(std::memory_order_relaxed);
+    stats.PeakSize = std::max(stats.PeakSize, _peakSize.load(std::memory_order_relaxed));
+    stats.Executed += _executed.load(std::memory_order_relaxed);
+    stats.TotalWaitUs += _totalWaitUs.load(std::memory_order_relaxed);
+    stats.MaxWaitUs = std::max(stats.MaxWaitUs, _maxWaitUs.load(std::memory_order_relaxed));
+}
+
+void SQLOperationQueue::ResetStats()
+{
+    _peakSize.store(_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _executed.store(0, std::memory_order_relaxed);
+    _totalWaitUs.store(0, std::memory_order_relaxed);
+    _maxWaitUs.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _SQLOPERATIONQUEUE_H
+#define _SQLOPERATIONQUEUE_H
+
+#include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+class SQLOperation;
+
+struct SQLOperationQueueStats
+{
+    uint64 Size = 0;            //! Operations queued or being executed
+    uint64 PeakSize = 0;        //! Highest size seen since the last reset
+    uint64 Executed = 0;        //! Operations executed since the last reset
+    uint64 TotalWaitUs = 0;     //! Time spent queued by the executed operations
+    uint64 MaxWaitUs = 0;       //! Longest time an operation spent queued since the last reset
+};
+
+/**
+ * Queue of a single asynchronous database connection.
+ *
+ * Each async connection has its own queue and worker thread, so workers never
+ * contend on a shared queue. Operations are executed in the order they were pushed.
+ * The size includes the operation being executed, so an idle queue has a size of zero.
+ */
+class SQLOperationQueue
+{
+public:
+    SQLOperationQueue();
+    ~SQLOperationQueue();
+
+    SQLOperationQueue(SQLOperationQueue const&) = delete;
+    SQLOperationQueue& operator=(SQLOperationQueue const&) = delete;
+
+    //! Takes ownership of the operation, can be called from any thread.
+    void Push(SQLOperation* op);
+
+    //! Blocks until an operation is available. Returns false once the queue is closed and empty.
+    bool WaitAndPop(SQLOperation*& op);
+
+    //! Called by the worker once the popped operation was executed.
+    void OnExecuted();
+
+    //! Wakes up the worker, operations already queued are still executed.
+    void Close();
+
+    uint64 GetSize() const { return _size.load(std::memory_order_relaxed); }
+
+    void FillStats(SQLOperationQueueStats& stats) const;
+    void ResetStats();
+
+private:
+    std::mutex _lock;
+    std::condition_variable _cond;
+    std::deque<SQLOperation*> _queue;
+    bool _closed;
+
+    std::atomic<uint64> _size;
+    std::atomic<uint64> _peakSize;
+    std::atomic<uint64> _executed;
+    std::atomic<uint64> _totalWaitUs;
+    std::atomic<uint64> _maxWaitUs;
+};
+
+#endif
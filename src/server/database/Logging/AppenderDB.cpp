@@ -5,6 +5,7 @@
 
 #include "AppenderDB.h"
 #include "DatabaseEnv.h"
+#include "Log.h"
 #include "LogMessage.h"
 #include "PreparedStatement.h"
 
@@ -25,9 +26,28 @@ void AppenderDB::_write(LogMessage const* message)
     stmt->setString(2, message->type);
     stmt->setUInt8(3, uint8(message->level));
     stmt->setString(4, message->text);
+
+    if (sLog->IsAsync())
+    {
+        if (!batch)
+            batch = LoginDatabase.BeginTransaction();
+
+        batch->Append(stmt);
+        return;
+    }
+
     LoginDatabase.Execute(stmt);
 }
 
+void AppenderDB::flush()
+{
+    if (!batch)
+        return;
+
+    LoginDatabase.CommitTransaction(batch);
+    batch = nullptr;
+}
+
 void AppenderDB::setRealmId(uint32 _realmId)
 {
     enabled = true;
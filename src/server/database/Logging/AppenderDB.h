@@ -7,6 +7,7 @@
 #define APPENDERDB_H
 
 #include "Appender.h"
+#include "Transaction.h"
 
 class AppenderDB : public Appender
 {
@@ -18,10 +19,13 @@ public:
 
     void setRealmId(uint32 realmId) override;
     AppenderType getType() const override { return type; }
+    void flush() override;
 
 private:
     uint32 realmId;
     bool enabled;
+    // lines of the current batch of the asynchronous log writer, inserted in one transaction
+    SQLTransaction batch;
     void _write(LogMessage const* message) override;
 };
 
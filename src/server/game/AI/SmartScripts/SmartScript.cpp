@@ -73,6 +73,8 @@ SmartScript::SmartScript()
     smartCasterPowerType = POWER_MANA;
 
     _allowPhaseReset = true;
+
+    mEventIndexOffsets.fill(0);
 }
 
 SmartScript::~SmartScript()
@@ -110,21 +112,33 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_AC_END)//special handling
+        return;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
+    for (uint32 i = mEventIndexOffsets[e]; i < mEventIndexOffsets[e + 1]; ++i)
+    {
+        SmartScriptHolder& holder = mEvents[mEventIndex[i]];
+        if (ConditionList const* conds = GetEventConditions(holder))
         {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
             ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
-
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
+            if (!sConditionMgr->IsObjectMeetToConditions(info, *conds))
+                continue;
         }
+
+        ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
+    }
+}
+
+ConditionList const* SmartScript::GetEventConditions(SmartScriptHolder& e) const
+{
+    uint32 generation = sConditionMgr->GetLoadGeneration();
+    if (e.conditionsGeneration != generation)
+    {
+        e.conditions = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+        e.conditionsGeneration = generation;
     }
+
+    return e.conditions;
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
@@ -3296,10 +3310,10 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     // xinef: extended by selfs victim
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+    ConditionList const* conds = GetEventConditions(e);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-    if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+    if (!conds || sConditionMgr->IsObjectMeetToConditions(info, *conds))
     {
         ProcessAction(e, unit, var0, var1, bvar, spell, gob);
         RecalcTimer(e, min, max);
@@ -4598,9 +4612,28 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
+void SmartScript::BuildEventIndex()
+{
+    // counting sort by event type, keeps the order of mEvents within a type
+    mEventIndexOffsets.fill(0);
+    for (SmartScriptHolder const& e : mEvents)
+        if (e.GetEventType() < SMART_EVENT_AC_END)
+            ++mEventIndexOffsets[e.GetEventType() + 1];
+
+    for (std::size_t type = 1; type < mEventIndexOffsets.size(); ++type)
+        mEventIndexOffsets[type] += mEventIndexOffsets[type - 1];
+
+    std::array<uint32, SMART_EVENT_AC_END + 1> position = mEventIndexOffsets;
+    mEventIndex.resize(mEventIndexOffsets[SMART_EVENT_AC_END]);
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() < SMART_EVENT_AC_END)
+            mEventIndex[position[mEvents[i].GetEventType()]++] = i;
+}
+
 void SmartScript::OnUpdate(uint32 const diff)
 {
     if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
@@ -4698,6 +4731,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    BuildEventIndex();
 }
 
 void SmartScript::GetScript()
@@ -259,6 +259,9 @@ private:
     void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
     SmartAIEventList mEvents;
+    // positions in mEvents grouped by event type, events of type t are mEventIndex[mEventIndexOffsets[t]] up to mEventIndex[mEventIndexOffsets[t + 1]]
+    std::vector<uint32> mEventIndex;
+    std::array<uint32, SMART_EVENT_AC_END + 1> mEventIndexOffsets;
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
@@ -294,6 +297,8 @@ private:
 
     SMARTAI_TEMPLATE mTemplate;
     void InstallEvents();
+    void BuildEventIndex();
+    ConditionList const* GetEventConditions(SmartScriptHolder& e) const;
 
     void RemoveStoredEvent (uint32 id)
     {
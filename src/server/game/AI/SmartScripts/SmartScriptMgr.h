@@ -8,6 +8,7 @@
 #define ACORE_SMARTSCRIPTMGR_H
 
 #include "Common.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Spell.h"
@@ -1679,7 +1680,7 @@ struct SmartScriptHolder
 {
     SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
         , event_id(0), link(0), event(), action(), target(), timer(0), active(false), runOnce(false)
-        , enableTimed(false) {}
+        , enableTimed(false), conditions(nullptr), conditionsGeneration(0) {}
 
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1700,6 +1701,10 @@ public:
     bool active;
     bool runOnce;
     bool enableTimed;
+
+    // conditions of the event, looked up again when ConditionMgr reloaded them
+    ConditionList const* conditions;
+    uint32 conditionsGeneration;
 };
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
@@ -16,6 +16,7 @@
 #include "Spell.h"
 #include "SpellAuras.h"
 #include "SpellMgr.h"
+#include <boost/container/small_vector.hpp>
 
 // Checks if object meets the condition
 // Can have CONDITION_SOURCE_TYPE_NONE && !mReferenceId if called from a special event (ie: eventAI)
@@ -67,8 +68,8 @@ bool Condition::Meets(ConditionSourceInfo& sourceInfo)
             {
                 if (Player* player = object->ToPlayer())
                 {
-                    if (FactionEntry const* faction = sFactionStore.LookupEntry(ConditionValue1))
-                        condMeets = (ConditionValue2 & (1 << player->GetReputationMgr().GetRank(faction)));
+                    if (Faction)
+                        condMeets = (ConditionValue2 & (1 << player->GetReputationMgr().GetRank(Faction)));
                 }
                 break;
             }
@@ -353,8 +354,7 @@ bool Condition::Meets(ConditionSourceInfo& sourceInfo)
             }
         case CONDITION_REALM_ACHIEVEMENT:
             {
-                AchievementEntry const* achievement = sAchievementStore.LookupEntry(ConditionValue1);
-                if (achievement && sAchievementMgr->IsRealmCompleted(achievement))
+                if (Achievement && sAchievementMgr->IsRealmCompleted(Achievement))
                     condMeets = true;
                 break;
             }
@@ -623,7 +623,7 @@ uint32 Condition::GetMaxAvailableConditionTargets()
     }
 }
 
-ConditionMgr::ConditionMgr()
+ConditionMgr::ConditionMgr() : LoadGeneration(0)
 {
 }
 
@@ -687,49 +687,74 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
     return mask;
 }
 
-bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
+bool ConditionMgr::IsObjectMeetToCondition(ConditionSourceInfo& sourceInfo, Condition* cond)
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
-    {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", (*i)->ConditionType, (*i)->ConditionValue1);
+    LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", cond->ConditionType, cond->ConditionValue1);
 #endif
-        if ((*i)->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == ElseGroupStore.end())
-                ElseGroupStore[(*i)->ElseGroup] = true;
-            else if (!(*itr).second)
-                continue;
+    if (cond->ReferenceId)//handle reference
+    {
+        if (cond->ReferencedConditions)
+            return IsObjectMeetToConditionList(sourceInfo, *cond->ReferencedConditions);
 
-            if ((*i)->ReferenceId)//handle reference
-            {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
-                        ElseGroupStore[(*i)->ElseGroup] = false;
-                }
-                else
-                {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                    LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -%u not found", (*i)->ReferenceId);
+        LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -%u not found", cond->ReferenceId);
 #endif
-                }
-            }
-            else //handle normal condition
+        return true;
+    }
+
+    //handle normal condition
+    return cond->Meets(sourceInfo);
+}
+
+bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
+{
+    // the object meets the list when all loaded conditions of one ElseGroup are met
+    auto elseGroupLess = [](Condition const* left, Condition const* right) { return left->ElseGroup < right->ElseGroup; };
+    if (std::is_sorted(conditions.begin(), conditions.end(), elseGroupLess))
+    {
+        // filled by AddToConditionList, every ElseGroup is a single run
+        for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end();)
+        {
+            uint32 elseGroup = (*i)->ElseGroup;
+            bool hasConditions = false;
+            bool groupCheckPassed = true;
+            for (; i != conditions.end() && (*i)->ElseGroup == elseGroup; ++i)
             {
-                if (!(*i)->Meets(sourceInfo))
-                    ElseGroupStore[(*i)->ElseGroup] = false;
+                if (!(*i)->isLoaded())
+                    continue;
+
+                hasConditions = true;
+                if (groupCheckPassed && !IsObjectMeetToCondition(sourceInfo, *i))
+                    groupCheckPassed = false;
             }
+
+            if (hasConditions && groupCheckPassed)
+                return true;
         }
+
+        return false;
     }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        if (i->second)
+
+    //     groupId, groupCheckPassed
+    boost::container::small_vector<std::pair<uint32, bool>, 4> ElseGroupStore;
+    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    {
+        if (!(*i)->isLoaded())
+            continue;
+
+        auto itr = std::find_if(ElseGroupStore.begin(), ElseGroupStore.end(), [i](std::pair<uint32, bool> const& group) { return group.first == (*i)->ElseGroup; });
+        if (itr == ElseGroupStore.end())
+            itr = ElseGroupStore.insert(ElseGroupStore.end(), std::make_pair((*i)->ElseGroup, true));
+        else if (!itr->second)
+            continue;
+
+        if (!IsObjectMeetToCondition(sourceInfo, *i))
+            itr->second = false;
+    }
+
+    for (std::pair<uint32, bool> const& group : ElseGroupStore)
+        if (group.second)
             return true;
 
     return false;
@@ -843,16 +868,16 @@ ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint
     return cond;
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
+ConditionList const* ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
-    ConditionList cond;
-    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
+    ConditionList const* cond = nullptr;
+    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(MAKE_PAIR64(uint32(entryOrGuid), sourceType));
     if (itr != SmartEventConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
+            cond = &(*i).second;
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
             LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %d event_id %u", entryOrGuid, eventId);
 #endif
@@ -882,6 +907,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++LoadGeneration;
 
     //must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -983,12 +1009,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (ConditionReferenceStore.find(uRefId) == ConditionReferenceStore.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                ConditionReferenceStore[uRefId] = mCondList;
-            }
-            ConditionReferenceStore[uRefId].push_back(cond);//add to reference storage
+            AddToConditionList(ConditionReferenceStore[uRefId], cond);//add to reference storage, creates the list for the reference id
             count++;
             continue;
         }//end of reference templates
@@ -1076,7 +1097,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                     {
-                        SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                        AddToConditionList(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                         valid = true;
                         ++count;
                         continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1086,23 +1107,22 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                     {
-                        VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                        AddToConditionList(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                         valid = true;
                         ++count;
                         continue;   // do not add to m_AllocatedMemory to avoid double deleting
                     }
                 case CONDITION_SOURCE_TYPE_SMART_EVENT:
                     {
-                        //! TODO: PAIR_32 ?
-                        std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                        SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                        uint64 key = MAKE_PAIR64(uint32(cond->SourceEntry), cond->SourceId);
+                        AddToConditionList(SmartEventConditionStore[key][cond->SourceGroup], cond);
                         valid = true;
                         ++count;
                         continue;
                     }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                     {
-                        NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                        AddToConditionList(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                         valid = true;
                         ++count;
                         continue;
@@ -1125,27 +1145,79 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
 
         //handle not grouped conditions
-        //make sure we have a storage list for our SourceType
-        if (ConditionStore.find(cond->SourceType) == ConditionStore.end())
+        //add new Condition to storage based on Type/Entry, the lists are created on first use
+        AddToConditionList(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
+        ++count;
+    } while (result->NextRow());
+
+    ResolveConditions();
+
+    LOG_INFO("server", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server", " ");
+}
+
+void ConditionMgr::AddToConditionList(ConditionList& conditions, Condition* cond)
+{
+    // after the last condition of the same ElseGroup, so conditions are still checked in table order within a group
+    ConditionList::iterator itr = std::upper_bound(conditions.begin(), conditions.end(), cond,
+        [](Condition const* left, Condition const* right) { return left->ElseGroup < right->ElseGroup; });
+    conditions.insert(itr, cond);
+}
+
+void ConditionMgr::ResolveConditions()
+{
+    // the stores are not changed anymore until the next reload, pointers into them stay valid
+    auto resolve = [this](Condition* cond)
+    {
+        if (cond->ReferenceId)
         {
-            ConditionTypeContainer mTypeMap;
-            ConditionStore[cond->SourceType] = mTypeMap;//add new empty list for SourceType
+            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(cond->ReferenceId);
+            cond->ReferencedConditions = ref != ConditionReferenceStore.end() ? &ref->second : nullptr;
+            return;
         }
 
-        //make sure we have a condition list for our SourceType's entry
-        if (ConditionStore[cond->SourceType].find(cond->SourceEntry) == ConditionStore[cond->SourceType].end())
+        switch (cond->ConditionType)
         {
-            ConditionList mCondList;
-            ConditionStore[cond->SourceType][cond->SourceEntry] = mCondList;
+            case CONDITION_REPUTATION_RANK:
+                cond->Faction = sFactionStore.LookupEntry(cond->ConditionValue1);
+                break;
+            case CONDITION_REALM_ACHIEVEMENT:
+                cond->Achievement = sAchievementStore.LookupEntry(cond->ConditionValue1);
+                break;
+            default:
+                break;
         }
+    };
 
-        //add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
-        ++count;
-    } while (result->NextRow());
+    auto resolveTypeContainer = [&resolve](ConditionTypeContainer& container)
+    {
+        for (ConditionTypeContainer::value_type& conditions : container)
+            for (Condition* cond : conditions.second)
+                resolve(cond);
+    };
 
-    LOG_INFO("server", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server", " ");
+    for (ConditionReferenceContainer::value_type& conditions : ConditionReferenceStore)
+        for (Condition* cond : conditions.second)
+            resolve(cond);
+
+    for (ConditionContainer::value_type& container : ConditionStore)
+        resolveTypeContainer(container.second);
+
+    for (CreatureSpellConditionContainer::value_type& container : VehicleSpellConditionStore)
+        resolveTypeContainer(container.second);
+
+    for (CreatureSpellConditionContainer::value_type& container : SpellClickEventConditionStore)
+        resolveTypeContainer(container.second);
+
+    for (NpcVendorConditionContainer::value_type& container : NpcVendorConditionContainerStore)
+        resolveTypeContainer(container.second);
+
+    for (SmartEventConditionContainer::value_type& container : SmartEventConditionStore)
+        resolveTypeContainer(container.second);
+
+    // loot, gossip and spell implicit target conditions
+    for (Condition* cond : AllocatedMemoryStore)
+        resolve(cond);
 }
 
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot)
@@ -1173,7 +1245,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1192,7 +1264,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1279,7 +1351,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond)
                     delete sharedList;
             }
             if (sharedList)
-                sharedList->push_back(cond);
+                AddToConditionList(*sharedList, cond);
             break;
         }
     }
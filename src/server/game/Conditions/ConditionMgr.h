@@ -11,12 +11,18 @@
 #include "Errors.h"
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 class Player;
 class Unit;
 class WorldObject;
 class LootTemplate;
+struct AchievementEntry;
 struct Condition;
+struct FactionEntry;
+
+typedef std::vector<Condition*> ConditionList;
 
 enum ConditionTypes
 {
@@ -194,6 +200,14 @@ struct Condition
     uint8                   ConditionTarget;
     bool                    NegativeCondition;
 
+    // resolved by ConditionMgr once all conditions are loaded
+    ConditionList const*    ReferencedConditions;
+    union
+    {
+        FactionEntry const*     Faction;           // CONDITION_REPUTATION_RANK
+        AchievementEntry const* Achievement;       // CONDITION_REALM_ACHIEVEMENT
+    };
+
     Condition()
     {
         SourceType         = CONDITION_SOURCE_TYPE_NONE;
@@ -211,6 +225,8 @@ struct Condition
         ErrorTextId        = 0;
         ScriptId           = 0;
         NegativeCondition  = false;
+        ReferencedConditions = nullptr;
+        Faction            = nullptr;
     }
 
     bool Meets(ConditionSourceInfo& sourceInfo);
@@ -219,14 +235,13 @@ struct Condition
     uint32 GetMaxAvailableConditionTargets();
 };
 
-typedef std::list<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList> ConditionTypeContainer;
-typedef std::map<ConditionSourceType, ConditionTypeContainer> ConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
-typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeContainer> SmartEventConditionContainer;
+typedef std::unordered_map<uint32, ConditionList> ConditionTypeContainer;
+typedef std::unordered_map<uint32 /*ConditionSourceType*/, ConditionTypeContainer> ConditionContainer;
+typedef std::unordered_map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
+typedef std::unordered_map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
+typedef std::unordered_map<uint64 /*entryOrGuid, SAI source_type*/, ConditionTypeContainer> SmartEventConditionContainer;
 
-typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
+typedef std::unordered_map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
 
 class ConditionMgr
 {
@@ -249,10 +264,17 @@ public:
     [[nodiscard]] bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
     ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
     ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
+    // points into the store, the list is freed by the next LoadConditions(), see GetLoadGeneration()
+    ConditionList const* GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
     ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
     ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
 
+    // keeps the conditions of an ElseGroup next to each other, lists filled this way are checked in a single pass
+    static void AddToConditionList(ConditionList& conditions, Condition* cond);
+
+    // changes every time the conditions are (re)loaded
+    [[nodiscard]] uint32 GetLoadGeneration() const { return LoadGeneration; }
+
 private:
     bool isSourceTypeValid(Condition* cond);
     bool addToLootTemplate(Condition* cond, LootTemplate* loot);
@@ -260,6 +282,8 @@ private:
     bool addToGossipMenuItems(Condition* cond);
     bool addToSpellImplicitTargetConditions(Condition* cond);
     bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
+    bool IsObjectMeetToCondition(ConditionSourceInfo& sourceInfo, Condition* cond);
+    void ResolveConditions();
 
     void Clean(); // free up resources
     std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
@@ -270,6 +294,7 @@ private:
     CreatureSpellConditionContainer   SpellClickEventConditionStore;
     NpcVendorConditionContainer       NpcVendorConditionContainerStore;
     SmartEventConditionContainer      SmartEventConditionStore;
+    uint32                            LoadGeneration;
 };
 
 #define sConditionMgr ConditionMgr::instance()
@@ -2282,6 +2282,9 @@ void GameObject::EnableCollision(bool enable)
         phaseMask = GetPhaseMask();
 
     m_model->enable(phaseMask);
+
+    if (IsInWorld())
+        GetMap()->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
@@ -2449,6 +2452,19 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     data->append(fieldBuffer);
 }
 
+bool GameObject::HasPlayerSpecificValuesUpdate() const
+{
+    // quest activation and transport progress are built for each target
+    if (IsUpdateFieldPending(GAMEOBJECT_DYNAMIC, GameObjectUpdateFieldFlags))
+        return true;
+
+    // group loot chests are locked for players not allowed to loot them
+    if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules)
+        return HasLootRecipient() || IsUpdateFieldPending(GAMEOBJECT_FLAGS, GameObjectUpdateFieldFlags);
+
+    return false;
+}
+
 void GameObject::GetRespawnPosition(float& x, float& y, float& z, float* ori /* = nullptr*/) const
 {
     if (m_spawnId)
@@ -2500,15 +2516,8 @@ float GameObject::GetInteractionDistance()
 
 void GameObject::UpdateModelPosition()
 {
-    if (!m_model)
-        return;
-
-    if (GetMap()->ContainsGameObjectModel(*m_model))
-    {
-        GetMap()->RemoveGameObjectModel(*m_model);
-        m_model->UpdatePosition();
-        GetMap()->InsertGameObjectModel(*m_model);
-    }
+    if (m_model)
+        GetMap()->UpdateGameObjectModel(*m_model);
 }
 
 std::unordered_map<int, goEventFlag> GameObject::gameObjectToEventFlag = { };
@@ -733,6 +733,7 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool HasPlayerSpecificValuesUpdate() const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
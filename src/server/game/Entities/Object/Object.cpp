@@ -4,6 +4,7 @@
  * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
  */
 
+#include "AccountMgr.h"
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "CellImpl.h"
@@ -482,7 +483,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* blockCache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -493,7 +494,40 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!blockCache)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    uint64 updateClass = GetValuesUpdateClass(player);
+    ValuesUpdateBlockCache::iterator block = std::find_if(blockCache->begin(), blockCache->end(),
+        [updateClass](ValuesUpdateBlockCache::value_type const& cached) { return cached.first == updateClass; });
+
+    if (block == blockCache->end())
+    {
+        blockCache->emplace_back(updateClass, ByteBuffer(500));
+        block = std::prev(blockCache->end());
+
+        block->second << (uint8) UPDATETYPE_VALUES;
+        block->second << GetPackGUID();
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block->second, player);
+    }
+
+    iter->second.AddUpdateBlock(block->second);
+}
+
+uint64 Object::GetValuesUpdateClass(Player const* target) const
+{
+    uint32* flags = nullptr;
+    uint64 updateClass = GetUpdateFieldData(target, flags);
+
+    // gamemasters see some fields differently (selectable flags, trigger models)
+    if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
+        updateClass |= UI64LIT(1) << 32;
+
+    return updateClass;
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -1106,19 +1140,9 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-        {
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        }
-
-        return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks);
+        LineOfSightQuery query;
+        GetLineOfSightPoints(ox, oy, oz, query);
+        return GetMap()->isInLineOfSight(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, GetPhaseMask(), checks);
     }
     return true;
 }
@@ -1128,25 +1152,44 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, LineOfSightChecks che
    if (!IsInMap(obj))
         return false;
 
-    float ox, oy, oz;
+    LineOfSightQuery query;
+    GetLineOfSightPoints(obj, query);
+    return GetMap()->isInLineOfSight(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, GetPhaseMask(), checks);
+}
+
+void WorldObject::GetLineOfSightPoints(float ox, float oy, float oz, LineOfSightQuery& query) const
+{
+    oz += GetCollisionHeight();
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(query.X1, query.Y1, query.Z1);
+        query.Z1 += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, query.X1, query.Y1, query.Z1);
+
+    query.X2 = ox;
+    query.Y2 = oy;
+    query.Z2 = oz;
+}
+
+void WorldObject::GetLineOfSightPoints(WorldObject const* obj, LineOfSightQuery& query) const
+{
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
-        obj->GetPosition(ox, oy, oz);
-        oz += obj->GetCollisionHeight();
+        obj->GetPosition(query.X2, query.Y2, query.Z2);
+        query.Z2 += obj->GetCollisionHeight();
     }
     else
-        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, ox, oy, oz);
+        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, query.X2, query.Y2, query.Z2);
 
-    float x, y, z;
     if (GetTypeId() == TYPEID_PLAYER)
     {
-        GetPosition(x, y, z);
-        z += GetCollisionHeight();
+        GetPosition(query.X1, query.Y1, query.Z1);
+        query.Z1 += GetCollisionHeight();
     }
     else
-        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z);
-
-    return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks);
+        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, query.X1, query.Y1, query.Z1);
 }
 
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const
@@ -2888,7 +2931,10 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
-    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
+    ValuesUpdateBlockCache i_blockCache;
+    bool i_shareBlocks;
+    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj),
+        i_shareBlocks(!obj.HasPlayerSpecificValuesUpdate())
     {
         i_playerSet.clear();
     }
@@ -2948,7 +2994,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUID()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_shareBlocks ? &i_blockCache : nullptr);
             i_playerSet.insert(player->GetGUID());
         }
     }
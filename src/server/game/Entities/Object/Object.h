@@ -70,6 +70,8 @@ class MotionTransport;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef GuidUnorderedSet UpdatePlayerSet;
+// values update blocks of one object, built once per visibility class and copied to every player of that class
+typedef std::vector<std::pair<uint64 /*visibility class*/, ByteBuffer>> ValuesUpdateBlockCache;
 
 class Object
 {
@@ -258,7 +260,10 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateBlockCache* blockCache = nullptr) const;
+    // true if the pending values update contains fields which are built differently for each player,
+    // players of the same visibility class can not share the update block then
+    [[nodiscard]] virtual bool HasPlayerSpecificValuesUpdate() const { return false; }
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -294,6 +299,8 @@ protected:
     void _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
     uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+    uint64 GetValuesUpdateClass(Player const* target) const;
+    [[nodiscard]] bool IsUpdateFieldPending(uint16 index, uint32 const* flags) const { return _changesMask.GetBit(index) || (_fieldNotifyFlags & flags[index]); }
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
@@ -880,6 +887,9 @@ public:
     }
     [[nodiscard]] bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
+    // fill the end points IsWithinLOS and IsWithinLOSInMap would check, used for batched checks
+    void GetLineOfSightPoints(float x, float y, float z, LineOfSightQuery& query) const;
+    void GetLineOfSightPoints(WorldObject const* obj, LineOfSightQuery& query) const;
     [[nodiscard]] Position GetHitSpherePointFor(Position const& dest) const;
     void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
     bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
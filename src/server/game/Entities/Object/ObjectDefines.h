@@ -33,6 +33,7 @@
 // used for creating values for respawn for example
 inline uint32 PAIR64_HIPART(uint64 x);
 inline uint32 PAIR64_LOPART(uint64 x);
+inline uint64 MAKE_PAIR64(uint32 l, uint32 h);
 inline uint16 MAKE_PAIR16(uint8 l, uint8 h);
 inline uint32 MAKE_PAIR32(uint16 l, uint16 h);
 inline uint16 PAIR32_HIPART(uint32 x);
@@ -48,6 +49,11 @@ uint32 PAIR64_LOPART(uint64 x)
     return (uint32)(x & UI64LIT(0x00000000FFFFFFFF));
 }
 
+uint64 MAKE_PAIR64(uint32 l, uint32 h)
+{
+    return uint64(l | (uint64(h) << 32));
+}
+
 uint16 MAKE_PAIR16(uint8 l, uint8 h)
 {
     return uint16(l | (uint16(h) << 8));
@@ -13,6 +13,9 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "zlib.h"
+#include <array>
+#include <atomic>
+#include <chrono>
 
 UpdateData::UpdateData() : m_blockCount(0)
 {
@@ -36,44 +39,109 @@ void UpdateData::AddUpdateBlock(const UpdateData& block)
     m_blockCount += block.m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // adaptive mode (Compression = 0): packets above this size (login, teleport and far sight bursts)
+    // use the fastest level, smaller ones the zlib default level
+    uint32 const ADAPTIVE_COMPRESSION_THRESHOLD = 16384;
+    int const ADAPTIVE_COMPRESSION_SMALL_LEVEL = 6;
+
+    // deflate streams of the current thread, one per compression level.
+    // Streams are initialized on first use and only reset afterwards.
+    class UpdateDataDeflateStreams
+    {
+    public:
+        UpdateDataDeflateStreams() : _initialized() { }
+
+        ~UpdateDataDeflateStreams()
+        {
+            for (int level = 0; level <= Z_BEST_COMPRESSION; ++level)
+                if (_initialized[level])
+                    deflateEnd(&_streams[level]);
+        }
+
+        z_stream* GetStream(int level)
+        {
+            z_stream* stream = &_streams[level];
+
+            if (_initialized[level])
+            {
+                int z_res = deflateReset(stream);
+                if (z_res == Z_OK)
+                    return stream;
+
+                LOG_ERROR("server", "Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                deflateEnd(stream);
+                _initialized[level] = false;
+            }
+
+            stream->zalloc = (alloc_func)0;
+            stream->zfree = (free_func)0;
+            stream->opaque = (voidpf)0;
+
+            int z_res = deflateInit(stream, level);
+            if (z_res != Z_OK)
+            {
+                LOG_ERROR("server", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            _initialized[level] = true;
+            return stream;
+        }
+
+    private:
+        std::array<z_stream, Z_BEST_COMPRESSION + 1> _streams;
+        std::array<bool, Z_BEST_COMPRESSION + 1> _initialized;
+    };
+
+    thread_local UpdateDataDeflateStreams deflateStreams;
+
+    // block count and out of range guids of the packet being built, reused by every packet built on the thread
+    thread_local ByteBuffer headerBuffer;
+
+    std::atomic<uint64> compressedPackets(0);
+    std::atomic<uint64> compressedBytesIn(0);
+    std::atomic<uint64> compressedBytesOut(0);
+    std::atomic<uint64> compressionTimeUs(0);
+}
+
+void UpdateData::Compress(void* dst, uint32* dst_size, ByteBuffer const& header, ByteBuffer const& data)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    uint32 srcSize = header.wpos() + data.wpos();
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    int level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    if (!level)
+        level = srcSize > ADAPTIVE_COMPRESSION_THRESHOLD ? Z_BEST_SPEED : ADAPTIVE_COMPRESSION_SMALL_LEVEL;
+
+    z_stream* c_stream = deflateStreams.GetStream(level);
+    if (!c_stream)
     {
-        LOG_ERROR("server", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)header.contents();
+    c_stream->avail_in = (uInt)header.wpos();
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
+    // the header and the update blocks are fed separately, so they never have to be copied into one buffer
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
+    if (z_res != Z_OK || c_stream->avail_in != 0)
     {
         LOG_ERROR("server", "Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    if (c_stream.avail_in != 0)
-    {
-        LOG_ERROR("server", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
+    c_stream->next_in = data.wpos() ? (Bytef*)data.contents() : nullptr;
+    c_stream->avail_in = (uInt)data.wpos();
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         LOG_ERROR("server", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -81,22 +149,20 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("server", "Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
 
-    *dst_size = c_stream.total_out;
+    compressedPackets.fetch_add(1, std::memory_order_relaxed);
+    compressedBytesIn.fetch_add(srcSize, std::memory_order_relaxed);
+    compressedBytesOut.fetch_add(*dst_size, std::memory_order_relaxed);
+    compressionTimeUs.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count(), std::memory_order_relaxed);
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
 {
     ASSERT(packet->empty());                                // shouldn't happen
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    ByteBuffer& buf = headerBuffer;
+    buf.clear();
 
     buf << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 
@@ -111,9 +177,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
         }
     }
 
-    buf.append(m_data);
-
-    size_t pSize = buf.wpos();                              // use real used data size
+    size_t pSize = buf.wpos() + m_data.wpos();              // use real used data size
 
     if (pSize > 100)                                       // compress large packets
     {
@@ -121,7 +185,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
         packet->resize(destsize + sizeof(uint32));
 
         packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, buf, m_data);
         if (destsize == 0)
             return false;
 
@@ -131,12 +195,23 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
     else                                                    // send small packets without compression
     {
         packet->append(buf);
+        packet->append(m_data);
         packet->SetOpcode(SMSG_UPDATE_OBJECT);
     }
 
     return true;
 }
 
+UpdateDataCompressionStats UpdateData::GetCompressionStats()
+{
+    UpdateDataCompressionStats stats;
+    stats.Packets = compressedPackets.load(std::memory_order_relaxed);
+    stats.BytesIn = compressedBytesIn.load(std::memory_order_relaxed);
+    stats.BytesOut = compressedBytesOut.load(std::memory_order_relaxed);
+    stats.TimeUs = compressionTimeUs.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void UpdateData::Clear()
 {
     m_data.clear();
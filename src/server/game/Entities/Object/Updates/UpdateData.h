@@ -37,6 +37,14 @@ enum OBJECT_UPDATE_FLAGS
     UPDATEFLAG_ROTATION             = 0x0200
 };
 
+struct UpdateDataCompressionStats
+{
+    uint64 Packets;
+    uint64 BytesIn;
+    uint64 BytesOut;
+    uint64 TimeUs;
+};
+
 class UpdateData
 {
 public:
@@ -49,11 +57,14 @@ public:
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
+    // totals of all SMSG_COMPRESSED_UPDATE_OBJECT packets built since startup
+    static UpdateDataCompressionStats GetCompressionStats();
+
 protected:
     uint32 m_blockCount;
     GuidVector m_outOfRangeGUIDs;
     ByteBuffer m_data;
 
-    void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+    void Compress(void* dst, uint32* dst_size, ByteBuffer const& header, ByteBuffer const& data);
 };
 #endif
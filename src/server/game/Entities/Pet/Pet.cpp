@@ -238,7 +238,7 @@ void Pet::SavePetToDB(PetSaveMode mode, bool logout)
 
     _SaveSpells(trans);
     _SaveSpellCooldowns(trans, logout);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, owner->GetGUID().GetCounter());
 
     // current/stable/not_in_slot
     if (mode >= PET_SAVE_AS_CURRENT)
@@ -297,7 +297,7 @@ void Pet::SavePetToDB(PetSaveMode mode, bool logout)
         stmt->setString(16, ss.str());
 
         trans->Append(stmt);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, ownerLowGUID);
     }
     // delete
     else
@@ -1870,7 +1870,7 @@ void Player::Update(uint32 p_time)
                 _SaveMonthlyQuestStatus(trans);
             }
 
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, GetGUID().GetCounter());
 
             m_additionalSaveTimer = 0;
             m_additionalSaveMask = 0;
@@ -20297,7 +20297,7 @@ void Player::SaveToDB(bool create, bool logout)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetGUID().GetCounter());
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
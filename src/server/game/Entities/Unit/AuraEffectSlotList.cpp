@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "AuraEffectSlotList.h"
+#include "SpellAuraEffects.h"
+#include "Util.h"
+
+void AuraEffectSlotList::UpdateTotals()
+{
+    _totalModifier = 0;
+    _totalMultiplier = 1.0f;
+    _maxPositiveModifier = 0;
+    _maxNegativeModifier = 0;
+
+    // same order as the list, the multiplier is rounded exactly like the old per call loops
+    for (AuraEffect const* aurEff : *this)
+    {
+        int32 amount = aurEff->GetAmount();
+        _totalModifier += amount;
+        AddPct(_totalMultiplier, amount);
+        _maxPositiveModifier = std::max(_maxPositiveModifier, amount);
+        _maxNegativeModifier = std::min(_maxNegativeModifier, amount);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _AURAEFFECTSLOTLIST_H
+#define _AURAEFFECTSLOTLIST_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+class AuraEffect;
+
+/*! Contiguous list of aura effects that can be changed while it is iterated.
+    remove() only clears the slot, iterators skip cleared slots and see effects added after them,
+    so loops may apply and remove auras like with the std::list this replaces.
+    Cleared slots are dropped by Compact(), which the owner calls when no iteration can be running.
+    The totals of the effect amounts are kept up to date, UpdateTotals() must be called when an amount changes. */
+class AuraEffectSlotList
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef AuraEffect* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef AuraEffect* const* pointer;
+        typedef AuraEffect* const& reference;
+
+        const_iterator() : _list(nullptr), _index(0) { }
+        const_iterator(AuraEffectSlotList const* list, std::size_t index) : _list(list), _index(index) { SkipForward(); }
+
+        reference operator*() const { return _list->_slots[_index]; }
+        pointer operator->() const { return &_list->_slots[_index]; }
+
+        const_iterator& operator++() { ++_index; SkipForward(); return *this; }
+        const_iterator operator++(int) { const_iterator itr = *this; ++*this; return itr; }
+
+        const_iterator& operator--()
+        {
+            // stops on the first slot, so reverse loops still meet rend() if the first effects were removed
+            _index = std::min(_index, _list->_slots.size());
+            while (_index > 0 && !_list->_slots[--_index]);
+            return *this;
+        }
+        const_iterator operator--(int) { const_iterator itr = *this; --*this; return itr; }
+
+        // iterators compare by the first effect at or after them, the slot they point to may have been cleared
+        bool operator==(const_iterator const& right) const { return GetPosition() == right.GetPosition(); }
+        bool operator!=(const_iterator const& right) const { return !(*this == right); }
+
+    private:
+        void SkipForward()
+        {
+            while (_index < _list->_slots.size() && !_list->_slots[_index])
+                ++_index;
+        }
+
+        std::size_t GetPosition() const
+        {
+            std::size_t position = _index;
+            while (position < _list->_slots.size() && !_list->_slots[position])
+                ++position;
+            return std::min(position, _list->_slots.size());
+        }
+
+        AuraEffectSlotList const* _list;
+        std::size_t _index;
+    };
+
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+    typedef AuraEffect* value_type;
+
+    AuraEffectSlotList() : _size(0), _totalModifier(0), _totalMultiplier(1.0f), _maxPositiveModifier(0), _maxNegativeModifier(0) { }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    // stays past the last slot when effects are added, like end() of a std::list
+    const_iterator end() const { return const_iterator(this, std::size_t(-1)); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const { return !_size; }
+    [[nodiscard]] std::size_t size() const { return _size; }
+    [[nodiscard]] AuraEffect* front() const { return *begin(); }
+    [[nodiscard]] AuraEffect* back() const { return *--end(); }
+    [[nodiscard]] bool HasFreeSlots() const { return _size != _slots.size(); }
+
+    // sum, product of the percentages, highest positive and lowest negative of all amounts
+    [[nodiscard]] int32 GetTotalModifier() const { return _totalModifier; }
+    [[nodiscard]] float GetTotalMultiplier() const { return _totalMultiplier; }
+    [[nodiscard]] int32 GetMaxPositiveModifier() const { return _maxPositiveModifier; }
+    [[nodiscard]] int32 GetMaxNegativeModifier() const { return _maxNegativeModifier; }
+
+    void UpdateTotals();
+
+    void push_back(AuraEffect* aurEff)
+    {
+        _slots.push_back(aurEff);
+        ++_size;
+        UpdateTotals();
+    }
+
+    void remove(AuraEffect* aurEff)
+    {
+        for (AuraEffect*& slot : _slots)
+        {
+            if (slot == aurEff)
+            {
+                slot = nullptr;
+                --_size;
+            }
+        }
+
+        UpdateTotals();
+    }
+
+    void Compact()
+    {
+        _slots.erase(std::remove(_slots.begin(), _slots.end(), nullptr), _slots.end());
+    }
+
+private:
+    std::vector<AuraEffect*> _slots;
+    std::size_t _size;
+    int32 _totalModifier;
+    float _totalMultiplier;
+    int32 _maxPositiveModifier;
+    int32 _maxNegativeModifier;
+};
+
+#endif
@@ -54,6 +54,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <boost/container/small_vector.hpp>
 #include <math.h>
 
 #ifdef ELUNA
@@ -61,6 +62,15 @@
 #include "ElunaEventMgr.h"
 #endif
 
+// Inline copy of an aura effect list, for loops that must not see auras applied while they run
+typedef boost::container::small_vector<AuraEffect*, 8> AuraEffectSnapshot;
+
+static AuraEffectSnapshot GetAuraEffectsSnapshot(Unit const* unit, AuraType type)
+{
+    Unit::AuraEffectList const& auraEffects = unit->GetAuraEffectsByType(type);
+    return AuraEffectSnapshot(auraEffects.begin(), auraEffects.end());
+}
+
 float baseMoveSpeed[MAX_MOVE_TYPE] =
 {
     2.5f,                  // MOVE_WALK
@@ -213,6 +223,8 @@ Unit::Unit(bool isWorldObject) : WorldObject(isWorldObject),
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_interruptMask = 0;
+    m_procAurasFlags = 0;
+    m_modAurasCompactPending = false;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -380,7 +392,7 @@ void Unit::Update(uint32 p_time)
             {
                 m_delayed_unit_relocation_timer = 0;
                 //ExecuteDelayedUnitRelocationEvent();
-                FindMap()->i_objectsForDelayedVisibility.insert(this);
+                FindMap()->AddObjectForDelayedVisibility(this);
             }
             else
                 m_delayed_unit_relocation_timer -= p_time;
@@ -656,6 +668,13 @@ bool Unit::GetRandomContactPoint(const Unit* obj, float& x, float& y, float& z,
     return true;
 }
 
+void Unit::UpdateProcAurasFlags()
+{
+    m_procAurasFlags = 0;
+    for (ProcAuraApplication const& procAura : m_procAuras)
+        m_procAurasFlags |= procAura.ProcFlags;
+}
+
 void Unit::UpdateInterruptMask()
 {
     m_interruptMask = 0;
@@ -763,11 +782,11 @@ uint32 Unit::DealDamage(Unit* attacker, Unit* victim, uint32 damage, CleanDamage
         else
             victim->RemoveAurasWithInterruptFlags(AURA_INTERRUPT_FLAG_TAKE_DAMAGE, 0);
 
-        // We're going to call functions which can modify content of the list during iteration over it's elements
-        // Let's copy the list so we can prevent iterator invalidation
-        AuraEffectList vCopyDamageCopy(victim->GetAuraEffectsByType(SPELL_AURA_SHARE_DAMAGE_PCT));
+        // We're going to call functions which can apply or remove auras of this type during the iteration
+        // Let's iterate over a copy so only the auras present before the damage are handled
+        AuraEffectSnapshot vCopyDamageCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_SHARE_DAMAGE_PCT);
         // copy damage to casters of this aura
-        for (AuraEffectList::iterator i = vCopyDamageCopy.begin(); i != vCopyDamageCopy.end(); ++i)
+        for (AuraEffectSnapshot::iterator i = vCopyDamageCopy.begin(); i != vCopyDamageCopy.end(); ++i)
         {
             // Check if aura was removed during iteration - we don't need to work on such auras
             if (!((*i)->GetBase()->IsAppliedOnTarget(victim->GetGUID())))
@@ -1597,10 +1616,10 @@ void Unit::DealMeleeDamage(CalcDamageInfo* damageInfo, bool durabilityLoss)
     // Do effect if any damage done to target
     if (damageInfo->damage)
     {
-        // We're going to call functions which can modify content of the list during iteration over it's elements
-        // Let's copy the list so we can prevent iterator invalidation
-        AuraEffectList vDamageShieldsCopy(victim->GetAuraEffectsByType(SPELL_AURA_DAMAGE_SHIELD));
-        for (AuraEffectList::const_iterator dmgShieldItr = vDamageShieldsCopy.begin(); dmgShieldItr != vDamageShieldsCopy.end(); ++dmgShieldItr)
+        // We're going to call functions which can apply or remove auras of this type during the iteration
+        // Let's iterate over a copy so only the auras present before the damage are handled
+        AuraEffectSnapshot vDamageShieldsCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_DAMAGE_SHIELD);
+        for (AuraEffectSnapshot::const_iterator dmgShieldItr = vDamageShieldsCopy.begin(); dmgShieldItr != vDamageShieldsCopy.end(); ++dmgShieldItr)
         {
             SpellInfo const* i_spellProto = (*dmgShieldItr)->GetSpellInfo();
             // Damage shield can be resisted...
@@ -1891,13 +1910,13 @@ void Unit::CalcAbsorbResist(Unit* attacker, Unit* victim, SpellSchoolMask school
         RoundToInterval(auraAbsorbMod, 0.0f, 100.0f);
     }
 
-    // We're going to call functions which can modify content of the list during iteration over it's elements
-    // Let's copy the list so we can prevent iterator invalidation
-    AuraEffectList vSchoolAbsorbCopy(victim->GetAuraEffectsByType(SPELL_AURA_SCHOOL_ABSORB));
-    vSchoolAbsorbCopy.sort(Acore::AbsorbAuraOrderPred());
+    // We're going to call functions which can apply or remove auras of this type during the iteration
+    // Let's iterate over a copy so only the auras present before the damage are handled
+    AuraEffectSnapshot vSchoolAbsorbCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_SCHOOL_ABSORB);
+    std::stable_sort(vSchoolAbsorbCopy.begin(), vSchoolAbsorbCopy.end(), Acore::AbsorbAuraOrderPred());
 
     // absorb without mana cost
-    for (AuraEffectList::iterator itr = vSchoolAbsorbCopy.begin(); (itr != vSchoolAbsorbCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
+    for (AuraEffectSnapshot::iterator itr = vSchoolAbsorbCopy.begin(); (itr != vSchoolAbsorbCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
     {
         AuraEffect* absorbAurEff = *itr;
         // Check if aura was removed during iteration - we don't need to work on such auras
@@ -1946,8 +1965,8 @@ void Unit::CalcAbsorbResist(Unit* attacker, Unit* victim, SpellSchoolMask school
     }
 
     // absorb by mana cost
-    AuraEffectList vManaShieldCopy(victim->GetAuraEffectsByType(SPELL_AURA_MANA_SHIELD));
-    for (AuraEffectList::const_iterator itr = vManaShieldCopy.begin(); (itr != vManaShieldCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
+    AuraEffectSnapshot vManaShieldCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_MANA_SHIELD);
+    for (AuraEffectSnapshot::const_iterator itr = vManaShieldCopy.begin(); (itr != vManaShieldCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
     {
         AuraEffect* absorbAurEff = *itr;
         // Check if aura was removed during iteration - we don't need to work on such auras
@@ -2009,10 +2028,10 @@ void Unit::CalcAbsorbResist(Unit* attacker, Unit* victim, SpellSchoolMask school
     // Xinef: not true - Warlock Hellfire
     if (/*victim != attacker &&*/ !Splited)
     {
-        // We're going to call functions which can modify content of the list during iteration over it's elements
-        // Let's copy the list so we can prevent iterator invalidation
-        AuraEffectList vSplitDamageFlatCopy(victim->GetAuraEffectsByType(SPELL_AURA_SPLIT_DAMAGE_FLAT));
-        for (AuraEffectList::iterator itr = vSplitDamageFlatCopy.begin(); (itr != vSplitDamageFlatCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
+        // We're going to call functions which can apply or remove auras of this type during the iteration
+        // Let's iterate over a copy so only the auras present before the damage are handled
+        AuraEffectSnapshot vSplitDamageFlatCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_SPLIT_DAMAGE_FLAT);
+        for (AuraEffectSnapshot::iterator itr = vSplitDamageFlatCopy.begin(); (itr != vSplitDamageFlatCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
         {
             // Check if aura was removed during iteration - we don't need to work on such auras
             if (!((*itr)->GetBase()->IsAppliedOnTarget(victim->GetGUID())))
@@ -2062,10 +2081,10 @@ void Unit::CalcAbsorbResist(Unit* attacker, Unit* victim, SpellSchoolMask school
             Unit::DealDamage(attacker, caster, splitted, &cleanDamage, DIRECT_DAMAGE, schoolMask, (*itr)->GetSpellInfo(), false);
         }
 
-        // We're going to call functions which can modify content of the list during iteration over it's elements
-        // Let's copy the list so we can prevent iterator invalidation
-        AuraEffectList vSplitDamagePctCopy(victim->GetAuraEffectsByType(SPELL_AURA_SPLIT_DAMAGE_PCT));
-        for (AuraEffectList::iterator itr = vSplitDamagePctCopy.begin(), next; (itr != vSplitDamagePctCopy.end()) &&  (dmgInfo.GetDamage() > 0); ++itr)
+        // We're going to call functions which can apply or remove auras of this type during the iteration
+        // Let's iterate over a copy so only the auras present before the damage are handled
+        AuraEffectSnapshot vSplitDamagePctCopy = GetAuraEffectsSnapshot(victim, SPELL_AURA_SPLIT_DAMAGE_PCT);
+        for (AuraEffectSnapshot::iterator itr = vSplitDamagePctCopy.begin(), next; (itr != vSplitDamagePctCopy.end()) &&  (dmgInfo.GetDamage() > 0); ++itr)
         {
             // Check if aura was removed during iteration - we don't need to work on such auras
             AuraApplication const* aurApp = (*itr)->GetBase()->GetApplicationOfTarget(victim->GetGUID());
@@ -3306,6 +3325,16 @@ void Unit::_DeleteRemovedAuras()
 
 void Unit::_UpdateSpells(uint32 time)
 {
+    // nothing iterates the aura effect lists of this unit here
+    if (m_modAurasCompactPending)
+    {
+        for (AuraEffectList& auraEffects : m_modAuras)
+            if (auraEffects.HasFreeSlots())
+                auraEffects.Compact();
+
+        m_modAurasCompactPending = false;
+    }
+
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
         _UpdateAutoRepeatSpell();
 
@@ -4073,6 +4102,15 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     AuraApplication* aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
+    if (uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(aurSpellInfo))
+    {
+        // same position as in m_appliedAuras, auras keep proccing in spell id order
+        ProcAuraApplicationList::iterator itr = std::upper_bound(m_procAuras.begin(), m_procAuras.end(), aurId,
+            [](uint32 spellId, ProcAuraApplication const& procAura) { return spellId < procAura.SpellId; });
+        m_procAuras.insert(itr, { aurId, procFlags, aurApp });
+        m_procAurasFlags |= procFlags;
+    }
+
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: even if it gets removed, it will be reapplied in a second
     if (aurSpellInfo->AuraInterruptFlags && this == aura->GetOwner())
@@ -4176,6 +4214,14 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
+    ProcAuraApplicationList::iterator procItr = std::find_if(m_procAuras.begin(), m_procAuras.end(),
+        [aurApp](ProcAuraApplication const& procAura) { return procAura.Application == aurApp; });
+    if (procItr != m_procAuras.end())
+    {
+        m_procAuras.erase(procItr);
+        UpdateProcAurasFlags();
+    }
+
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: event if it gets removed, it will be reapplied in a second
     if (aura->GetSpellInfo()->AuraInterruptFlags && this == aura->GetOwner())
@@ -4290,7 +4336,11 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
     if (apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
+    {
+        // the slot is only cleared, the list may be iterated further up the stack
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+        m_modAurasCompactPending = true;
+    }
 }
 
 // All aura base removes should go threw this function!
@@ -5442,53 +5492,22 @@ int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    if (mTotalAuraList.empty())
-        return 0;
-
-    int32 modifier = 0;
-
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
-
-    return modifier;
+    return GetAuraEffectsByType(auratype).GetTotalModifier();
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return GetAuraEffectsByType(auratype).GetTotalMultiplier();
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraEffectsByType(auratype).GetMaxPositiveModifier();
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-
-    return modifier;
+    return GetAuraEffectsByType(auratype).GetMaxNegativeModifier();
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -15316,7 +15335,7 @@ struct ProcTriggeredData
     }
 };
 
-typedef std::list< ProcTriggeredData > ProcTriggeredList;
+typedef boost::container::small_vector<ProcTriggeredData, 8> ProcTriggeredList;
 
 // List of auras that CAN be trigger but may not exist in spell_proc_event
 // in most case need for drop charges
@@ -15608,6 +15627,10 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         }
     }
 
+    // Only auras whose proc flags share a bit with procFlag can pass IsTriggeredAtSpellProcEvent
+    if (!(procFlag & m_procAurasFlags))
+        return;
+
     Unit* actor = isVictim ? target : this;
     Unit* actionTarget = !isVictim ? target : this;
 
@@ -15615,25 +15638,37 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     HealInfo healInfo = HealInfo(actor, actionTarget, damage, procSpell, procSpell ? SpellSchoolMask(procSpell->SchoolMask) : SPELL_SCHOOL_MASK_NORMAL);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, nullptr, &damageInfo, &healInfo, procAura);
 
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
+    // The checks below may run scripts that apply or remove auras, so the candidates are copied first
+    // and their applications looked up again, Aura objects stay valid until the next aura update
+    boost::container::small_vector<std::pair<uint32, Aura*>, 16> procAuras;
+    for (ProcAuraApplication const& procAuraApp : m_procAuras)
+        if (procFlag & procAuraApp.ProcFlags)
+            procAuras.emplace_back(procAuraApp.SpellId, procAuraApp.Application->GetBase());
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+    for (auto const& [spellId, aura] : procAuras)
     {
+        AuraApplication* aurApp = aura->GetApplicationOfTarget(GetGUID());
+        if (!aurApp || aurApp->GetRemoveMode())
+            continue;
+
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == spellId)
             continue;
 
         // Xinef: Generic Item Equipment cooldown, -1 is a special marker
-        if (itr->second->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
+        if (aura->GetCastItemGUID() && HasSpellItemCooldown(spellId, uint32(-1)))
             continue;
 
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aura);
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aura->GetSpellInfo();
 
         // only auras that have trigger spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -15655,7 +15690,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             continue;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
             continue;
 
         // Triggered spells not triggering additional spells
@@ -15665,9 +15700,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool hasTriggeredProc = false;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aura->GetEffect(i);
 
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
@@ -15722,12 +15757,12 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
                 if (!proccessed)
                 {
-                    procTriggered.push_front(triggerData);
+                    procTriggered.insert(procTriggered.begin(), triggerData);
                 }
             }
             else
             {
-                procTriggered.push_front(triggerData);
+                procTriggered.insert(procTriggered.begin(), triggerData);
             }
         }
     }
@@ -20198,6 +20233,19 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     data->append(fieldBuffer);
 }
 
+bool Unit::HasPlayerSpecificValuesUpdate() const
+{
+    // fields written by Unit::BuildValuesUpdate depending on the target itself, not only on its visibility class
+    static uint16 const playerSpecificFields[] = { UNIT_NPC_FLAGS, UNIT_FIELD_AURASTATE, UNIT_DYNAMIC_FLAGS, UNIT_FIELD_BYTES_2, UNIT_FIELD_FACTIONTEMPLATE };
+
+    for (uint16 index : playerSpecificFields)
+        if (IsUpdateFieldPending(index, UnitUpdateFieldFlags))
+            return true;
+
+    // per caster aura states are always sent
+    return HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK);
+}
+
 void Unit::BuildCooldownPacket(WorldPacket& data, uint8 flags, uint32 spellId, uint32 cooldown)
 {
     data.Initialize(SMSG_SPELL_COOLDOWN, 8 + 1 + 4 + 4);
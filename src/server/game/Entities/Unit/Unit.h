@@ -7,6 +7,7 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraEffectSlotList.h"
 #include "EventProcessor.h"
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
@@ -1399,7 +1400,15 @@ public:
     typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    struct ProcAuraApplication
+    {
+        uint32 SpellId;
+        uint32 ProcFlags;               // SpellMgr::GetSpellProcEventFlags of the aura
+        AuraApplication* Application;
+    };
+    typedef std::vector<ProcAuraApplication> ProcAuraApplicationList;
+
+    typedef AuraEffectSlotList AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication*> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
@@ -1957,6 +1966,7 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    void UpdateAuraEffectTotals(AuraType auraType) { m_modAuras[auraType].UpdateTotals(); }
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -2215,6 +2225,7 @@ public:
     [[nodiscard]] uint32 GetInterruptMask() const { return m_interruptMask; }
     void AddInterruptMask(uint32 mask) { m_interruptMask |= mask; }
     void UpdateInterruptMask();
+    void UpdateProcAurasFlags();
 
     uint32 GetDisplayId() { return GetUInt32Value(UNIT_FIELD_DISPLAYID); }
     virtual void SetDisplayId(uint32 modelId);
@@ -2501,6 +2512,7 @@ protected:
     explicit Unit (bool isWorldObject);
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool HasPlayerSpecificValuesUpdate() const override;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2541,9 +2553,12 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    bool m_modAurasCompactPending;             // some m_modAuras have free slots, compacted in _UpdateSpells
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+    ProcAuraApplicationList m_procAuras;       // applied auras with proc flags, in m_appliedAuras order
+    uint32 m_procAurasFlags;                   // all proc flags of m_procAuras
     uint32 m_interruptMask;
 
     float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
@@ -37,6 +37,7 @@
 #include "Vehicle.h"
 #include "WaypointManager.h"
 #include "World.h"
+#include "WorldDataCache.h"
 
 ScriptMapMap sSpellScripts;
 ScriptMapMap sEventScripts;
@@ -1815,6 +1816,20 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    // no snapshot when the zone and area of every spawn is written back to the database
+    std::string cacheKey;
+    if (sWorldDataCache->IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA))
+    {
+        // spawn masks come from Map.dbc and MapDifficulty.dbc, transport maps from gameobject_template
+        cacheKey = sWorldDataCache->GetKey({ "Map.dbc", "MapDifficulty.dbc" }, "Calculate.Creature.Zone.Area.Data=0;");
+        if (LoadCreaturesFromCache(cacheKey))
+        {
+            LOG_INFO("server", ">> Loaded %u creatures from the world data cache in %u ms", uint32(_creatureDataStore.size()), GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", " ");
+            return;
+        }
+    }
+
     //                                               0              1   2    3        4             5           6           7           8            9              10
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance, "
                          //   11               12         13       14            15         16         17          18          19                20                   21
@@ -1839,6 +1854,7 @@ void ObjectMgr::LoadCreatures()
                     spawnMasks[i] |= (1 << k);
 
     _creatureDataStore.rehash(result->GetRowCount());
+    std::vector<ObjectGuid::LowType> gridSpawns;
     uint32 count = 0;
     do
     {
@@ -1969,15 +1985,110 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(spawnId, &data);
+            if (!cacheKey.empty())
+                gridSpawns.push_back(spawnId);
+        }
 
         ++count;
     } while (result->NextRow());
 
+    if (!cacheKey.empty())
+        SaveCreaturesToCache(cacheKey, gridSpawns);
+
     LOG_INFO("server", ">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 }
 
+bool ObjectMgr::LoadCreaturesFromCache(std::string const& key)
+{
+    WorldDataCache::Reader reader;
+    if (!sWorldDataCache->Open("creature", key, reader))
+        return false;
+
+    uint32 count = reader.Read<uint32>();
+    _creatureDataStore.rehash(count);
+    for (uint32 i = 0; i < count && reader.IsValid(); ++i)
+    {
+        CreatureData& data      = _creatureDataStore[reader.Read<uint32>()];
+        data.id                 = reader.Read<uint32>();
+        data.mapid              = reader.Read<uint16>();
+        data.phaseMask          = reader.Read<uint32>();
+        data.displayid          = reader.Read<uint32>();
+        data.equipmentId        = reader.Read<int8>();
+        data.posX               = reader.Read<float>();
+        data.posY               = reader.Read<float>();
+        data.posZ               = reader.Read<float>();
+        data.orientation        = reader.Read<float>();
+        data.spawntimesecs      = reader.Read<uint32>();
+        data.wander_distance    = reader.Read<float>();
+        data.currentwaypoint    = reader.Read<uint32>();
+        data.curhealth          = reader.Read<uint32>();
+        data.curmana            = reader.Read<uint32>();
+        data.movementType       = reader.Read<uint8>();
+        data.spawnMask          = reader.Read<uint8>();
+        data.npcflag            = reader.Read<uint32>();
+        data.unit_flags         = reader.Read<uint32>();
+        data.dynamicflags       = reader.Read<uint32>();
+        data.dbData             = reader.Read<uint8>() != 0;
+        data.overwrittenZ       = reader.Read<uint8>() != 0;
+    }
+
+    std::vector<ObjectGuid::LowType> gridSpawns(reader.Read<uint32>());
+    for (ObjectGuid::LowType& spawnId : gridSpawns)
+        spawnId = reader.Read<uint32>();
+
+    if (!reader.IsValid() || !reader.IsAtEnd())
+    {
+        LOG_ERROR("server", "World data cache of creatures does not match this version, loading from the database");
+        _creatureDataStore.clear();
+        return false;
+    }
+
+    for (ObjectGuid::LowType spawnId : gridSpawns)
+        AddCreatureToGrid(spawnId, &_creatureDataStore[spawnId]);
+
+    return true;
+}
+
+void ObjectMgr::SaveCreaturesToCache(std::string const& key, std::vector<ObjectGuid::LowType> const& gridSpawns) const
+{
+    ByteBuffer buffer(_creatureDataStore.size() * 70 + gridSpawns.size() * 4 + 8);
+    buffer << uint32(_creatureDataStore.size());
+    for (auto const& [spawnId, data] : _creatureDataStore)
+    {
+        buffer << uint32(spawnId);
+        buffer << uint32(data.id);
+        buffer << uint16(data.mapid);
+        buffer << uint32(data.phaseMask);
+        buffer << uint32(data.displayid);
+        buffer << int8(data.equipmentId);
+        buffer << float(data.posX);
+        buffer << float(data.posY);
+        buffer << float(data.posZ);
+        buffer << float(data.orientation);
+        buffer << uint32(data.spawntimesecs);
+        buffer << float(data.wander_distance);
+        buffer << uint32(data.currentwaypoint);
+        buffer << uint32(data.curhealth);
+        buffer << uint32(data.curmana);
+        buffer << uint8(data.movementType);
+        buffer << uint8(data.spawnMask);
+        buffer << uint32(data.npcflag);
+        buffer << uint32(data.unit_flags);
+        buffer << uint32(data.dynamicflags);
+        buffer << uint8(data.dbData);
+        buffer << uint8(data.overwrittenZ);
+    }
+
+    buffer << uint32(gridSpawns.size());
+    for (ObjectGuid::LowType spawnId : gridSpawns)
+        buffer << uint32(spawnId);
+
+    sWorldDataCache->Save("creature", key, buffer);
+}
+
 void ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType guid, CreatureData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -2116,6 +2227,19 @@ void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    // no snapshot when the zone and area of every spawn is written back to the database
+    std::string cacheKey;
+    if (sWorldDataCache->IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA))
+    {
+        cacheKey = sWorldDataCache->GetKey({ "Map.dbc", "MapDifficulty.dbc", "GameObjectDisplayInfo.dbc" }, "Calculate.Gameoject.Zone.Area.Data=0;");
+        if (LoadGameobjectsFromCache(cacheKey))
+        {
+            LOG_INFO("server", ">> Loaded %lu gameobjects from the world data cache in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+            LOG_INFO("server", " ");
+            return;
+        }
+    }
+
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
@@ -2141,6 +2265,7 @@ void ObjectMgr::LoadGameobjects()
                     spawnMasks[i] |= (1 << k);
 
     _gameObjectDataStore.rehash(result->GetRowCount());
+    std::vector<ObjectGuid::LowType> gridSpawns;
     do
     {
         Field* fields = result->Fetch();
@@ -2271,14 +2396,101 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        {
             AddGameobjectToGrid(guid, &data);
+            if (!cacheKey.empty())
+                gridSpawns.push_back(guid);
+        }
         ++count;
     } while (result->NextRow());
 
+    if (!cacheKey.empty())
+        SaveGameobjectsToCache(cacheKey, gridSpawns);
+
     LOG_INFO("server", ">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 }
 
+bool ObjectMgr::LoadGameobjectsFromCache(std::string const& key)
+{
+    WorldDataCache::Reader reader;
+    if (!sWorldDataCache->Open("gameobject", key, reader))
+        return false;
+
+    uint32 count = reader.Read<uint32>();
+    _gameObjectDataStore.rehash(count);
+    for (uint32 i = 0; i < count && reader.IsValid(); ++i)
+    {
+        GameObjectData& data = _gameObjectDataStore[reader.Read<uint32>()];
+        data.id             = reader.Read<uint32>();
+        data.mapid          = reader.Read<uint16>();
+        data.phaseMask      = reader.Read<uint32>();
+        data.posX           = reader.Read<float>();
+        data.posY           = reader.Read<float>();
+        data.posZ           = reader.Read<float>();
+        data.orientation    = reader.Read<float>();
+        data.rotation.x     = reader.Read<float>();
+        data.rotation.y     = reader.Read<float>();
+        data.rotation.z     = reader.Read<float>();
+        data.rotation.w     = reader.Read<float>();
+        data.spawntimesecs  = reader.Read<int32>();
+        data.animprogress   = reader.Read<uint32>();
+        data.go_state       = GOState(reader.Read<uint8>());
+        data.spawnMask      = reader.Read<uint8>();
+        data.artKit         = reader.Read<uint8>();
+        data.dbData         = reader.Read<uint8>() != 0;
+    }
+
+    std::vector<ObjectGuid::LowType> gridSpawns(reader.Read<uint32>());
+    for (ObjectGuid::LowType& guid : gridSpawns)
+        guid = reader.Read<uint32>();
+
+    if (!reader.IsValid() || !reader.IsAtEnd())
+    {
+        LOG_ERROR("server", "World data cache of gameobjects does not match this version, loading from the database");
+        _gameObjectDataStore.clear();
+        return false;
+    }
+
+    for (ObjectGuid::LowType guid : gridSpawns)
+        AddGameobjectToGrid(guid, &_gameObjectDataStore[guid]);
+
+    return true;
+}
+
+void ObjectMgr::SaveGameobjectsToCache(std::string const& key, std::vector<ObjectGuid::LowType> const& gridSpawns) const
+{
+    ByteBuffer buffer(_gameObjectDataStore.size() * 60 + gridSpawns.size() * 4 + 8);
+    buffer << uint32(_gameObjectDataStore.size());
+    for (auto const& [guid, data] : _gameObjectDataStore)
+    {
+        buffer << uint32(guid);
+        buffer << uint32(data.id);
+        buffer << uint16(data.mapid);
+        buffer << uint32(data.phaseMask);
+        buffer << float(data.posX);
+        buffer << float(data.posY);
+        buffer << float(data.posZ);
+        buffer << float(data.orientation);
+        buffer << float(data.rotation.x);
+        buffer << float(data.rotation.y);
+        buffer << float(data.rotation.z);
+        buffer << float(data.rotation.w);
+        buffer << int32(data.spawntimesecs);
+        buffer << uint32(data.animprogress);
+        buffer << uint8(data.go_state);
+        buffer << uint8(data.spawnMask);
+        buffer << uint8(data.artKit);
+        buffer << uint8(data.dbData);
+    }
+
+    buffer << uint32(gridSpawns.size());
+    for (ObjectGuid::LowType guid : gridSpawns)
+        buffer << uint32(guid);
+
+    sWorldDataCache->Save("gameobject", key, buffer);
+}
+
 void ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType guid, GameObjectData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -1430,6 +1430,12 @@ private:
     void LoadQuestRelationsHelper(QuestRelations& map, std::string const& table, bool starter, bool go);
     void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
 
+    // spawns read from and written to the world data cache, gridSpawns are the spawns not managed by game events or pools
+    bool LoadCreaturesFromCache(std::string const& key);
+    void SaveCreaturesToCache(std::string const& key, std::vector<ObjectGuid::LowType> const& gridSpawns) const;
+    bool LoadGameobjectsFromCache(std::string const& key);
+    void SaveGameobjectsToCache(std::string const& key, std::vector<ObjectGuid::LowType> const& gridSpawns) const;
+
     MailLevelRewardContainer _mailLevelRewardStore;
 
     CreatureBaseStatsContainer _creatureBaseStatsStore;
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "WorldDataCache.h"
+#include "ByteBuffer.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "World.h"
+#include <boost/crc.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+    uint32 const WORLD_DATA_CACHE_MAGIC     = 0x44574341; // "ACWD"
+    uint32 const WORLD_DATA_CACHE_VERSION   = 1;          // increase when the layout of any snapshot changes
+
+    // magic, version, key length, payload size, payload crc32
+    std::size_t const WORLD_DATA_CACHE_HEADER_SIZE = 4 + 4 + 4 + 8 + 4;
+
+    uint32 GetChecksum(uint8 const* data, std::size_t size)
+    {
+        boost::crc_32_type crc;
+        crc.process_bytes(data, size);
+        return crc.checksum();
+    }
+}
+
+WorldDataCache* WorldDataCache::instance()
+{
+    static WorldDataCache instance;
+    return &instance;
+}
+
+WorldDataCache::Reader::Reader() : _data(nullptr), _size(0), _position(0), _overflow(false) { }
+
+WorldDataCache::Reader::~Reader() = default;
+
+std::string WorldDataCache::GetKey(std::initializer_list<char const*> dbcFiles, std::string const& settings) const
+{
+    // every applied update adds its revision to version_db_world, a few thousand short rows instead of the tables themselves
+    QueryResult result = WorldDatabase.Query("SELECT sql_rev FROM version_db_world ORDER BY sql_rev");
+    if (!result)
+        return "";
+
+    boost::crc_32_type updates;
+    do
+    {
+        std::string_view revision = result->Fetch()[0].GetStringView();
+        updates.process_bytes(revision.data(), revision.size());
+        updates.process_byte(0);
+    } while (result->NextRow());
+
+    std::ostringstream key;
+    key << "core=" << GitRevision::GetHash() << ';';
+    key << "updates=" << result->GetRowCount() << ':' << updates.checksum() << ';';
+
+    std::string dbcPath = sWorld->GetDataPath() + "dbc/";
+    for (char const* dbcFile : dbcFiles)
+    {
+        std::ifstream file(dbcPath + dbcFile, std::ios::binary);
+        if (!file)
+            return "";
+
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        key << dbcFile << '=' << GetChecksum(reinterpret_cast<uint8 const*>(contents.data()), contents.size()) << ';';
+    }
+
+    key << settings;
+    return key.str();
+}
+
+std::string WorldDataCache::GetFileName(char const* name) const
+{
+    std::string fileName = _directory;
+    if (!fileName.empty() && fileName.back() != '/' && fileName.back() != '\\')
+        fileName.push_back('/');
+
+    return fileName + name + ".cache";
+}
+
+bool WorldDataCache::Open(char const* name, std::string const& key, Reader& reader) const
+{
+    if (key.empty())
+        return false;
+
+    std::string fileName = GetFileName(name);
+
+    auto file = std::make_unique<boost::iostreams::mapped_file_source>();
+    try
+    {
+        file->open(fileName);
+    }
+    catch (std::exception const&)
+    {
+        LOG_INFO("server", "World data cache %s not found, loading from the database", fileName.c_str());
+        return false;
+    }
+
+    reader._file = std::move(file);
+    reader._data = reinterpret_cast<uint8 const*>(reader._file->data());
+    reader._size = reader._file->size();
+    reader._position = 0;
+    reader._overflow = false;
+
+    if (reader.Read<uint32>() != WORLD_DATA_CACHE_MAGIC || reader.Read<uint32>() != WORLD_DATA_CACHE_VERSION)
+    {
+        LOG_INFO("server", "World data cache %s was written by another version, loading from the database", fileName.c_str());
+        return false;
+    }
+
+    uint32 keyLength = reader.Read<uint32>();
+    uint64 payloadSize = reader.Read<uint64>();
+    uint32 payloadChecksum = reader.Read<uint32>();
+    if (!reader.IsValid() || reader._size - WORLD_DATA_CACHE_HEADER_SIZE != keyLength + payloadSize)
+    {
+        LOG_ERROR("server", "World data cache %s is truncated, loading from the database", fileName.c_str());
+        return false;
+    }
+
+    if (key.size() != keyLength || key.compare(0, keyLength, reinterpret_cast<char const*>(reader._data + reader._position), keyLength) != 0)
+    {
+        LOG_INFO("server", "World data cache %s is outdated, loading from the database", fileName.c_str());
+        return false;
+    }
+
+    reader._position += keyLength;
+
+    if (GetChecksum(reader._data + reader._position, payloadSize) != payloadChecksum)
+    {
+        LOG_ERROR("server", "World data cache %s is damaged, loading from the database", fileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void WorldDataCache::Save(char const* name, std::string const& key, ByteBuffer const& data) const
+{
+    if (key.empty())
+        return;
+
+    ByteBuffer header(WORLD_DATA_CACHE_HEADER_SIZE + key.size());
+    header << uint32(WORLD_DATA_CACHE_MAGIC);
+    header << uint32(WORLD_DATA_CACHE_VERSION);
+    header << uint32(key.size());
+    header << uint64(data.size());
+    header << uint32(GetChecksum(data.contents(), data.size()));
+    header.append(key.c_str(), key.size());
+
+    // written next to the snapshot and renamed, a server that is killed while saving keeps the old file
+    std::string fileName = GetFileName(name);
+    std::string tempFileName = fileName + ".tmp";
+
+    FILE* file = fopen(tempFileName.c_str(), "wb");
+    if (!file)
+    {
+        LOG_ERROR("server", "World data cache %s can not be written", tempFileName.c_str());
+        return;
+    }
+
+    bool written = fwrite(header.contents(), header.size(), 1, file) == 1 && fwrite(data.contents(), data.size(), 1, file) == 1;
+    written = fclose(file) == 0 && written;
+
+    // rename does not replace existing files on every platform
+    if (written && std::rename(tempFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::remove(fileName.c_str());
+        written = std::rename(tempFileName.c_str(), fileName.c_str()) == 0;
+    }
+
+    if (!written)
+    {
+        LOG_ERROR("server", "World data cache %s can not be written", fileName.c_str());
+        std::remove(tempFileName.c_str());
+        return;
+    }
+
+    LOG_INFO("server", ">> Saved world data cache %s (%u bytes)", fileName.c_str(), uint32(header.size() + data.size()));
+}
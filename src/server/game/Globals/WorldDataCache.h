@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_WORLDDATACACHE_H
+#define ACORE_WORLDDATACACHE_H
+
+#include "ByteConverter.h"
+#include "Define.h"
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+class ByteBuffer;
+
+namespace boost::iostreams
+{
+    class mapped_file_source;
+}
+
+/// Binary snapshots of validated world data, read instead of the source tables on the next start.
+/// A snapshot is keyed by the applied world database updates and the other inputs of its loader,
+/// and ignored once any of them changed.
+class WorldDataCache
+{
+private:
+    WorldDataCache() : _enabled(false), _startup(true) { }
+    ~WorldDataCache() = default;
+
+public:
+    static WorldDataCache* instance();
+
+    /// Snapshots are only used while the world loads, reload commands always read the tables
+    bool IsEnabled() const { return _enabled && _startup; }
+    void SetEnabled(bool enabled) { _enabled = enabled; }
+    void EndStartup() { _startup = false; }
+    void SetDirectory(std::string const& directory) { _directory = directory; }
+
+    /// Reads the values of a snapshot in the order they were written, straight from the mapped file
+    class Reader
+    {
+    public:
+        Reader();
+        ~Reader();
+
+        template<class T>
+        T Read()
+        {
+            T value = T();
+            if (_position + sizeof(T) > _size)
+            {
+                _overflow = true;
+                return value;
+            }
+
+            std::memcpy(&value, _data + _position, sizeof(T));
+            EndianConvert(value);
+            _position += sizeof(T);
+            return value;
+        }
+
+        /// False if more values were read than the snapshot contains
+        bool IsValid() const { return !_overflow; }
+        bool IsAtEnd() const { return _position == _size; }
+
+    private:
+        friend class WorldDataCache;
+
+        std::unique_ptr<boost::iostreams::mapped_file_source> _file;
+        uint8 const* _data;
+        std::size_t _size;
+        std::size_t _position;
+        bool _overflow;
+    };
+
+    /// Identifies the core revision, the updates applied to the world database, the contents of the given
+    /// DBC files and the settings the loader depends on. Empty if any of them could not be read.
+    /// Tables edited by hand, without an update, are not noticed: delete the snapshots after such changes.
+    std::string GetKey(std::initializer_list<char const*> dbcFiles, std::string const& settings) const;
+
+    /// Maps the snapshot, returns false if it is missing, damaged or was built from other table contents
+    bool Open(char const* name, std::string const& key, Reader& reader) const;
+    void Save(char const* name, std::string const& key, ByteBuffer const& data) const;
+
+private:
+    std::string GetFileName(char const* name) const;
+
+    bool _enabled;
+    bool _startup;
+    std::string _directory;
+};
+
+#define sWorldDataCache WorldDataCache::instance()
+
+#endif
@@ -874,7 +874,7 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder, playerGuid.GetCounter());
 }
 
 void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder* holder)
@@ -284,7 +284,7 @@ uint8 WorldSession::HandleLoadPetFromDBFirstCallback(PreparedQueryResult result,
     }
     _loadPetFromDBSecondCallback.cancel();
 
-    _loadPetFromDBSecondCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    _loadPetFromDBSecondCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder, owner->GetGUID().GetCounter());
     return PET_LOAD_OK;
 }
 
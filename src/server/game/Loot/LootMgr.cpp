@@ -16,6 +16,7 @@
 #include "SpellMgr.h"
 #include "Util.h"
 #include "World.h"
+#include "WorldDataCache.h"
 
 static Rates const qualityToRate[MAX_ITEM_QUALITY] =
 {
@@ -130,6 +131,18 @@ uint32 LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
+    // rows are validated against item_template only, which the applied updates already describe
+    std::string cacheKey;
+    if (sWorldDataCache->IsEnabled())
+    {
+        cacheKey = sWorldDataCache->GetKey({}, "");
+        if (uint32 count = LoadLootTableFromCache(cacheKey))
+        {
+            Verify();
+            return count;
+        }
+    }
+
     //                                                  0     1            2               3         4         5             6
     QueryResult result = WorldDatabase.PQuery("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName());
 
@@ -137,6 +150,8 @@ uint32 LootStore::LoadLootTable()
         return 0;
 
     uint32 count = 0;
+    ByteBuffer cache(cacheKey.empty() ? 0 : result->GetRowCount() * 21 + 4);
+    cache << uint32(0);
 
     do
     {
@@ -190,13 +205,58 @@ uint32 LootStore::LoadLootTable()
         // Adds current row to the template
         tab->second->AddEntry(storeitem);
         ++count;
+
+        if (!cacheKey.empty())
+            cache << uint32(entry) << uint32(item) << uint32(reference) << float(chance) << uint8(needsquest) << uint16(lootmode) << uint8(groupid) << uint8(mincount) << uint8(maxcount);
     } while (result->NextRow());
 
+    if (!cacheKey.empty())
+    {
+        cache.put<uint32>(0, count);
+        sWorldDataCache->Save(GetName(), cacheKey, cache);
+    }
+
     Verify();                                           // Checks validity of the loot store
 
     return count;
 }
 
+uint32 LootStore::LoadLootTableFromCache(std::string const& key)
+{
+    WorldDataCache::Reader reader;
+    if (!sWorldDataCache->Open(GetName(), key, reader))
+        return 0;
+
+    uint32 count = reader.Read<uint32>();
+    for (uint32 i = 0; i < count && reader.IsValid(); ++i)
+    {
+        uint32 entry        = reader.Read<uint32>();
+        uint32 item         = reader.Read<uint32>();
+        uint32 reference    = reader.Read<uint32>();
+        float  chance       = reader.Read<float>();
+        bool   needsquest   = reader.Read<uint8>() != 0;
+        uint16 lootmode     = reader.Read<uint16>();
+        uint8  groupid      = reader.Read<uint8>();
+        uint8  mincount     = reader.Read<uint8>();
+        uint8  maxcount     = reader.Read<uint8>();
+
+        LootTemplate*& lootTemplate = m_LootTemplates[entry];
+        if (!lootTemplate)
+            lootTemplate = new LootTemplate();
+
+        lootTemplate->AddEntry(new LootStoreItem(item, reference, chance, needsquest, lootmode, groupid, mincount, maxcount));
+    }
+
+    if (!reader.IsValid() || !reader.IsAtEnd())
+    {
+        LOG_ERROR("server", "World data cache of %s does not match this version, loading from the database", GetName());
+        Clear();
+        return 0;
+    }
+
+    return count;
+}
+
 bool LootStore::HaveQuestLootFor(uint32 loot_id) const
 {
     LootTemplateMap::const_iterator itr = m_LootTemplates.find(loot_id);
@@ -1642,7 +1702,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
-                (*i)->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList((*i)->conditions, cond);
                 return true;
             }
         }
@@ -1663,7 +1723,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -1676,7 +1736,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -223,6 +223,8 @@ protected:
     uint32 LoadLootTable();
     void Clear();
 private:
+    uint32 LoadLootTableFromCache(std::string const& key);
+
     LootTemplateMap m_LootTemplates;
     char const* m_name;
     char const* m_entryName;
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "LineOfSightCache.h"
+#include <algorithm>
+#include <cmath>
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks)
+{
+    auto quantize = [](float value) { return int32(std::floor(value * LOS_CACHE_PRECISION)); };
+
+    std::array<int32, 3> start = { quantize(x1), quantize(y1), quantize(z1) };
+    std::array<int32, 3> end = { quantize(x2), quantize(y2), quantize(z2) };
+    if (end < start)
+        std::swap(start, end);
+
+    Key key;
+    std::copy(start.begin(), start.end(), key.Points.begin());
+    std::copy(end.begin(), end.end(), key.Points.begin() + 3);
+    key.PhaseMask = phaseMask;
+    key.Checks = checks;
+    return key;
+}
+
+std::size_t LineOfSightCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hash = std::hash<uint32>()(key.PhaseMask) ^ (std::size_t(key.Checks) << 1);
+    for (int32 point : key.Points)
+        hash ^= std::hash<int32>()(point) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+LineOfSightCache::Shard& LineOfSightCache::GetShard(Key const& key, uint32 generation, std::unique_lock<std::mutex>& guard)
+{
+    Shard& shard = _shards[KeyHash()(key) % LOS_CACHE_SHARDS];
+    guard = std::unique_lock<std::mutex>(shard.Lock);
+    if (shard.Generation != generation)
+    {
+        shard.Entries.clear();
+        shard.Generation = generation;
+    }
+
+    return shard;
+}
+
+bool LineOfSightCache::Find(Key const& key, uint32 generation, bool& inLineOfSight)
+{
+    std::unique_lock<std::mutex> guard;
+    Shard& shard = GetShard(key, generation, guard);
+
+    auto itr = shard.Entries.find(key);
+    if (itr == shard.Entries.end())
+        return false;
+
+    inLineOfSight = itr->second;
+    return true;
+}
+
+void LineOfSightCache::Store(Key const& key, uint32 generation, bool inLineOfSight)
+{
+    std::unique_lock<std::mutex> guard;
+    Shard& shard = GetShard(key, generation, guard);
+
+    if (shard.Entries.size() < LOS_CACHE_MAX_SHARD_ENTRIES)
+        shard.Entries.emplace(key, inLineOfSight);
+}
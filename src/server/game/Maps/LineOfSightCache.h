@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _LINE_OF_SIGHT_CACHE_H
+#define _LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+// end points are rounded to 1/LOS_CACHE_PRECISION yards
+#define LOS_CACHE_PRECISION         8.0f
+#define LOS_CACHE_SHARDS            16
+#define LOS_CACHE_MAX_SHARD_ENTRIES 2048
+
+// Line of sight answers of one map.
+// Entries are only valid for the generation they were stored with, the map changes its generation at the start
+// of every update and whenever the static or dynamic collision changes (grids, doors, transports).
+// The segment direction does not matter, A to B and B to A share an entry.
+class LineOfSightCache
+{
+public:
+    struct Key
+    {
+        std::array<int32, 6> Points;
+        uint32 PhaseMask;
+        uint32 Checks;
+
+        bool operator==(Key const& right) const
+        {
+            return Points == right.Points && PhaseMask == right.PhaseMask && Checks == right.Checks;
+        }
+    };
+
+    LineOfSightCache() = default;
+
+    static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks);
+
+    bool Find(Key const& key, uint32 generation, bool& inLineOfSight);
+    void Store(Key const& key, uint32 generation, bool inLineOfSight);
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    // region updates of the same map check line of sight concurrently
+    struct Shard
+    {
+        std::mutex Lock;
+        std::unordered_map<Key, bool, KeyHash> Entries;
+        uint32 Generation = 0;
+    };
+
+    Shard& GetShard(Key const& key, uint32 generation, std::unique_lock<std::mutex>& guard);
+
+    std::array<Shard, LOS_CACHE_SHARDS> _shards;
+};
+
+#endif
@@ -17,15 +17,30 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "MapInstanced.h"
+#include "MapManager.h"
+#include "MapRegionUpdate.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
+#include "UpdateProfiler.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
+#include "World.h"
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifdef ELUNA
 #include "LuaEngine.h"
@@ -43,6 +58,9 @@ u_map_magic MapAreaMagic    = { {'A', 'R', 'E', 'A'} };
 u_map_magic MapHeightMagic  = { {'M', 'H', 'G', 'T'} };
 u_map_magic MapLiquidMagic  = { {'M', 'L', 'I', 'Q'} };
 
+// region the calling thread is updating, see Map::UpdateRegion
+static thread_local MapRegionContext* RegionContext = nullptr;
+
 Map::~Map()
 {
     // UnloadAll must be called before deleting the map
@@ -62,7 +80,6 @@ Map::~Map()
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     //MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId());
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -216,6 +233,7 @@ void Map::LoadMapAndVMap(int gx, int gy)
     {
         LoadVMap(gx, gy);                                   // Only load the data for the base map
         LoadMMap(gx, gy);
+        InvalidateLineOfSightCache();
     }
 }
 
@@ -236,6 +254,14 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
         }
     }
 
+    CreateGuidSequenceGenerator<HighGuid::Transport>();
+    CreateGuidSequenceGenerator<HighGuid::Unit>();
+    CreateGuidSequenceGenerator<HighGuid::Vehicle>();
+    CreateGuidSequenceGenerator<HighGuid::Pet>();
+    CreateGuidSequenceGenerator<HighGuid::GameObject>();
+    CreateGuidSequenceGenerator<HighGuid::DynamicObject>();
+    CreateGuidSequenceGenerator<HighGuid::Corpse>();
+
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
@@ -455,6 +481,14 @@ void Map::EnsureGridCreated_i(const GridCoord& p)
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
+    // loading spawns objects into cells other regions may be reading, the merge phase loads the grid instead
+    if (MapRegionContext* context = GetRegionContext())
+    {
+        if (!IsGridLoaded(GridCoord(cell.GridX(), cell.GridY())))
+            context->GridsToLoad.push_back(cell);
+        return false;
+    }
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -471,8 +505,6 @@ bool Map::EnsureGridLoaded(const Cell& cell)
 
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
-
-        Balance();
         return true;
         //}
     }
@@ -545,6 +577,8 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    auto guard = GetRegionUpdateGuard();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -729,43 +763,109 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Acore::Objec
 
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
+    UpdateProfilerScope profileMap(UPDATE_SECTION_MAP, GetId());
+
     if (t_diff)
-        _dynamicTree.update(t_diff);
+    {
+        _pathCache.Clear();
+        _pathBudgetUsed.store(0, std::memory_order_relaxed);
+        InvalidateLineOfSightCache();
+    }
 
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->GetSource();
-        if (player && player->IsInWorld())
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_SESSIONS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(s_diff, updater);
+            Player* player = m_mapRefIter->GetSource();
+            if (player && player->IsInWorld())
+            {
+                //player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(s_diff, updater);
+            }
         }
     }
 
     if (!t_diff)
     {
-        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            Player* player = m_mapRefIter->GetSource();
+            UpdateProfilerScope profile(UPDATE_SECTION_MAP_CELLS);
+            for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+            {
+                Player* player = m_mapRefIter->GetSource();
 
-            if (!player || !player->IsInWorld())
-                continue;
+                if (!player || !player->IsInWorld())
+                    continue;
 
-            // update players at tick
-            player->Update(s_diff);
+                // update players at tick
+                player->Update(s_diff);
+            }
         }
 
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_VISIBILITY);
         HandleDelayedVisibility();
         return;
     }
 
     /// update active cells around players and active objects
-    resetMarkedCells();
-    resetMarkedCellsLarge();
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_CELLS);
+        resetMarkedCells();
+        resetMarkedCellsLarge();
+
+        if (CanUpdateInRegions())
+            UpdateActiveCellsInRegions(t_diff, s_diff);
+        else
+            UpdateActiveCells(t_diff, s_diff);
+    }
+
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_TRANSPORTS);
+        for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
+        {
+            MotionTransport* transport = *_transportsUpdateIter;
+            ++_transportsUpdateIter;
+
+            if (!transport->IsInWorld())
+                continue;
+
+            transport->Update(t_diff);
+        }
+    }
+
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_OBJECT_UPDATES);
+        SendObjectUpdates();
+    }
+
+    ///- Process necessary scripts
+    if (!m_scriptSchedule.empty())
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_SCRIPTS);
+        i_scriptLock = true;
+        ScriptsProcess();
+        i_scriptLock = false;
+    }
+
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_MOVE_LISTS);
+        MoveAllCreaturesInMoveList();
+        MoveAllGameObjectsInMoveList();
+        MoveAllDynamicObjectsInMoveList();
+    }
+
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_MAP_VISIBILITY);
+        HandleDelayedVisibility();
+    }
+
+    sScriptMgr->OnMapUpdate(this, t_diff);
+}
 
+void Map::UpdateActiveCells(uint32 t_diff, uint32 s_diff)
+{
     Acore::ObjectUpdater updater(t_diff, false);
 
     // for creature
@@ -840,35 +940,290 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
                 VisitNearbyCellsOf(*itr, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
         }
     }
+}
+
+bool Map::CanUpdateInRegions() const
+{
+    // instances are too small to profit from it, only continents are split
+    // regions search paths concurrently, which relies on MMapManager handing out one navmesh query per thread
+    if (Instanceable() || !sWorld->getBoolConfig(CONFIG_MAP_REGION_UPDATE))
+        return false;
+
+#ifdef ELUNA
+    // lua events of every unit run from Unit::Update
+    return false;
+#endif
+
+    // module hooks called from every creature update can not be kept on the map thread
+    if (!sMapMgr->GetMapUpdater()->activated() || sScriptMgr->HasUnitUpdateHooks())
+        return false;
+
+    return m_mapRefManager.getSize() >= sWorld->getIntConfig(CONFIG_MAP_REGION_UPDATE_MIN_PLAYERS);
+}
+
+void Map::UpdateActiveCellsInRegions(uint32 t_diff, uint32 s_diff)
+{
+    std::vector<uint32> largeCells;
+
+    // same order as UpdateActiveCells, first the cells around non-player active objects
+    {
+        MapRegionPartition partition(MAP_REGION_HALO_CELLS);
+
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
+
+            if (!obj || !obj->IsInWorld())
+                continue;
+
+            CollectNearbyCellsOf(obj, partition, largeCells);
+        }
+
+        UpdateRegions(partition, t_diff);
+    }
 
-    for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
+    // then the players, on the map thread, and the cells around them not updated yet
+    MapRegionPartition partition(MAP_REGION_HALO_CELLS);
+
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        MotionTransport* transport = *_transportsUpdateIter;
-        ++_transportsUpdateIter;
+        Player* player = m_mapRefIter->GetSource();
 
-        if (!transport->IsInWorld())
+        if (!player || !player->IsInWorld())
             continue;
 
-        transport->Update(t_diff);
+        player->Update(s_diff);
+
+        CollectNearbyCellsOfPlayer(player, partition, largeCells);
+
+        if (WorldObject* viewPoint = player->GetViewpoint())
+            if (viewPoint->ToCreature() || viewPoint->ToDynObject())
+                CollectNearbyCellsOf(viewPoint, partition, largeCells);
+
+        // creatures in combat with a far player must share its region
+        if (player->IsInCombat())
+        {
+            float rangeSq = player->GetGridActivationRange() - 1.0f;
+            rangeSq = rangeSq * rangeSq;
+            uint32 playerCellId = MapRegionPartition::GetCellId(player->GetPositionX(), player->GetPositionY());
+            HostileReference* ref = player->getHostileRefManager().getFirst();
+            while (ref)
+            {
+                if (Unit* unit = ref->GetSource()->GetOwner())
+                    if (Creature* cre = unit->ToCreature())
+                        if (cre->FindMap() == this && cre->GetExactDist2dSq(player) > rangeSq)
+                        {
+                            CollectNearbyCellsOf(cre, partition, largeCells);
+                            partition.Link(playerCellId, MapRegionPartition::GetCellId(cre->GetPositionX(), cre->GetPositionY()));
+                        }
+                ref = ref->next();
+            }
+        }
     }
 
-    SendObjectUpdates();
+    UpdateRegions(partition, t_diff);
 
-    ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
+    // large creatures can interact across regions, update them after the merge
+    Acore::ObjectUpdater largeObjectUpdater(t_diff, true);
+    TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_large_object_update(largeObjectUpdater);
+    TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer  > world_large_object_update(largeObjectUpdater);
+
+    for (uint32 cellId : largeCells)
     {
-        i_scriptLock = true;
-        ScriptsProcess();
-        i_scriptLock = false;
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        Visit(cell, grid_large_object_update);
+        Visit(cell, world_large_object_update);
+    }
+}
+
+void Map::UpdateRegions(MapRegionPartition& partition, uint32 t_diff)
+{
+    std::vector<MapRegionPartition::CellList> regions;
+    partition.Build(regions);
+
+    if (regions.size() <= 1)
+    {
+        if (!regions.empty())
+            UpdateRegion(regions.front(), nullptr, t_diff);
+        return;
     }
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
-    MoveAllDynamicObjectsInMoveList();
+    std::shared_ptr<MapRegionUpdateBatch> batch = std::make_shared<MapRegionUpdateBatch>(*this, std::move(regions), t_diff);
 
-    HandleDelayedVisibility();
+    _regionUpdateInProgress = true;
 
-    sScriptMgr->OnMapUpdate(this, t_diff);
+    for (size_t i = 1; i < batch->GetRegionCount(); ++i)
+        sMapMgr->GetMapUpdater()->schedule_region_update(batch);
+
+    // the map thread takes part in the work, so waiting can not starve the MapUpdater
+    batch->Process();
+    batch->Wait();
+
+    _regionUpdateInProgress = false;
+
+    for (MapRegionContext& context : batch->GetContexts())
+        MergeRegion(context, t_diff);
+}
+
+MapRegionContext* Map::GetRegionContext() const
+{
+    return RegionContext && RegionContext->Owner == this ? RegionContext : nullptr;
+}
+
+void Map::UpdateRegion(std::vector<uint32> const& cells, MapRegionContext* context, uint32 t_diff)
+{
+    // a single region is updated on the map thread, nothing has to be deferred
+    if (!context)
+    {
+        Acore::ObjectUpdater updater(t_diff, false);
+        TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+        for (uint32 cellId : cells)
+        {
+            Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+        return;
+    }
+
+    MapRegionObjectUpdater updater(*context, t_diff);
+    TypeContainerVisitor<MapRegionObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<MapRegionObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    RegionContext = context;
+
+    for (uint32 cellId : cells)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+
+    RegionContext = nullptr;
+}
+
+void Map::MergeRegion(MapRegionContext& context, uint32 t_diff)
+{
+    for (Cell const& cell : context.GridsToLoad)
+        EnsureGridLoaded(cell);
+
+    for (auto const& [obj, add] : context.UpdateObjects)
+    {
+        if (add)
+            AddUpdateObject(obj);
+        else
+            RemoveUpdateObject(obj);
+    }
+
+    i_objectsForDelayedVisibility.insert(context.DelayedVisibility.begin(), context.DelayedVisibility.end());
+    _creaturesToMove.insert(_creaturesToMove.end(), context.CreaturesToMove.begin(), context.CreaturesToMove.end());
+    _gameObjectsToMove.insert(_gameObjectsToMove.end(), context.GameObjectsToMove.begin(), context.GameObjectsToMove.end());
+    _dynamicObjectsToMove.insert(_dynamicObjectsToMove.end(), context.DynamicObjectsToMove.begin(), context.DynamicObjectsToMove.end());
+
+    for (auto const& [obj, on] : context.ObjectsToSwitch)
+        AddObjectToSwitchList(obj, on);
+
+    for (WorldObject* obj : context.ObjectsToRemove)
+        AddObjectToRemoveList(obj);
+
+    // looked up again, earlier updates of this merge may have removed them
+    for (ObjectGuid const& guid : context.DeferredObjects)
+    {
+        WorldObject* obj = nullptr;
+        switch (guid.GetHigh())
+        {
+            case HighGuid::Unit:
+            case HighGuid::Vehicle:
+                obj = GetCreature(guid);
+                break;
+            case HighGuid::Pet:
+                obj = GetPet(guid);
+                break;
+            case HighGuid::GameObject:
+            case HighGuid::Transport:
+                obj = GetGameObject(guid);
+                break;
+            case HighGuid::DynamicObject:
+                obj = GetDynamicObject(guid);
+                break;
+            default:
+                break;
+        }
+
+        if (obj && obj->IsInWorld())
+            obj->Update(t_diff);
+    }
+}
+
+void Map::CollectNearbyCellsOf(WorldObject* obj, MapRegionPartition& partition, std::vector<uint32>& largeCells)
+{
+    if (!obj->IsPositionValid() || obj->GetGridActivationRange() <= 0.0f)
+        return;
+
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+
+            markCell(cell_id);
+            partition.AddCell(cell_id);
+
+            // grids are loaded here, never from inside a region
+            EnsureGridLoaded(Cell(CellCoord(x, y)));
+
+            if (!isCellMarkedLarge(cell_id))
+            {
+                markCellLarge(cell_id);
+                largeCells.push_back(cell_id);
+            }
+        }
+    }
+}
+
+void Map::CollectNearbyCellsOfPlayer(Player* player, MapRegionPartition& partition, std::vector<uint32>& largeCells)
+{
+    if (!player->IsPositionValid())
+        return;
+
+    CollectNearbyCellsOf(player, partition, largeCells);
+
+    CellArea area = Cell::CalculateCellArea(player->GetPositionX(), player->GetPositionY(), MAX_VISIBILITY_DISTANCE);
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarkedLarge(cell_id))
+                continue;
+
+            markCellLarge(cell_id);
+            EnsureGridLoaded(Cell(CellCoord(x, y)));
+            largeCells.push_back(cell_id);
+        }
+    }
+}
+
+bool Map::ConsumePathBudget()
+{
+    uint32 budget = sWorld->getIntConfig(CONFIG_MMAP_PATH_BUDGET);
+    return !budget || _pathBudgetUsed.fetch_add(1, std::memory_order_relaxed) < budget;
+}
+
+void Map::AddObjectForDelayedVisibility(Unit* unit)
+{
+    if (MapRegionContext* context = GetRegionContext())
+        context->DelayedVisibility.push_back(unit);
+    else
+        i_objectsForDelayedVisibility.insert(unit);
 }
 
 void Map::HandleDelayedVisibility()
@@ -922,6 +1277,8 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    auto guard = GetRegionUpdateGuard();
+
     bool inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1069,7 +1426,12 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 void Map::AddCreatureToMoveList(Creature* c)
 {
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _creaturesToMove.push_back(c);
+    {
+        if (MapRegionContext* context = GetRegionContext())
+            context->CreaturesToMove.push_back(c);
+        else
+            _creaturesToMove.push_back(c);
+    }
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1082,7 +1444,12 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _gameObjectsToMove.push_back(go);
+    {
+        if (MapRegionContext* context = GetRegionContext())
+            context->GameObjectsToMove.push_back(go);
+        else
+            _gameObjectsToMove.push_back(go);
+    }
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1095,7 +1462,12 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _dynamicObjectsToMove.push_back(dynObj);
+    {
+        if (MapRegionContext* context = GetRegionContext())
+            context->DynamicObjectsToMove.push_back(dynObj);
+        else
+            _dynamicObjectsToMove.push_back(dynObj);
+    }
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1231,6 +1603,7 @@ bool Map::UnloadGrid(NGridType& ngrid)
         // x and y are swapped
         VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
         MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+        InvalidateLineOfSightCache();
     }
 
     GridMaps[gx][gy] = nullptr;
@@ -1328,6 +1701,8 @@ GridMap::GridMap()
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
+    _mappedData = nullptr;
+    _mappedSize = 0;
 }
 
 GridMap::~GridMap()
@@ -1344,7 +1719,14 @@ bool GridMap::loadData(char* filename)
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
     if (!in)
-        return true;
+    {
+        if (errno == ENOENT)
+            return true;
+
+        // running out of file descriptors must not silently leave the grid without terrain
+        LOG_ERROR("maps", "Map file '%s' can not be opened: %s", filename, strerror(errno));
+        return false;
+    }
 
     if (fread(&header, sizeof(header), 1, in) != 1)
     {
@@ -1354,6 +1736,13 @@ bool GridMap::loadData(char* filename)
 
     if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
     {
+        // files with misaligned sections (written by older extractors) are read into memory instead
+        if (sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED) && loadMappedData(filename, header))
+        {
+            fclose(in);
+            return true;
+        }
+
         // loadup area data
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
@@ -1385,14 +1774,19 @@ bool GridMap::loadData(char* filename)
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    // arrays of a mapped file point into the mapping, only the flight bounds are copied
+    if (!_mappedData)
+    {
+        delete[] _areaMap;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] _liquidEntry;
+        delete[] _liquidFlags;
+        delete[] _liquidMap;
+    }
     delete[] _maxHeight;
     delete[] _minHeight;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
+    unmapFile();
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -1512,6 +1906,188 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+bool GridMap::mapFile(char const* filename)
+{
+    // the mapping stays valid after the file is closed
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return false;
+
+    _mappedSize = std::size_t(size.QuadPart);
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+        data = mmap(nullptr, std::size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    _mappedSize = std::size_t(fileStat.st_size);
+#endif
+
+    _mappedData = static_cast<uint8*>(data);
+    return true;
+}
+
+void GridMap::unmapFile()
+{
+    if (!_mappedData)
+        return;
+
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+    UnmapViewOfFile(_mappedData);
+#else
+    munmap(_mappedData, _mappedSize);
+#endif
+
+    _mappedData = nullptr;
+    _mappedSize = 0;
+}
+
+bool GridMap::loadMappedData(char const* filename, map_fileheader const& header)
+{
+    if (!mapFile(filename))
+    {
+        LOG_ERROR("maps", "Could not map file '%s'", filename);
+        return false;
+    }
+
+    if ((header.areaMapOffset && !loadMappedAreaData(header.areaMapOffset)) ||
+        (header.heightMapOffset && !loadMappedHeightData(header.heightMapOffset)) ||
+        (header.liquidMapOffset && !loadMappedLiquidData(header.liquidMapOffset)))
+    {
+        unloadData();
+        return false;
+    }
+
+    return true;
+}
+
+template<class T>
+T* GridMap::getMappedArray(uint32& offset, uint32 count) const
+{
+    if (offset % alignof(T) || uint64(offset) + uint64(count) * sizeof(T) > _mappedSize)
+        return nullptr;
+
+    T* data = reinterpret_cast<T*>(_mappedData + offset);
+    offset += count * sizeof(T);
+    return data;
+}
+
+bool GridMap::loadMappedAreaData(uint32 offset)
+{
+    map_areaHeader const* header = getMappedArray<map_areaHeader>(offset, 1);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
+        return false;
+
+    _gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
+        if (!(_areaMap = getMappedArray<uint16>(offset, 16 * 16)))
+            return false;
+
+    return true;
+}
+
+bool GridMap::loadMappedHeightData(uint32 offset)
+{
+    map_heightHeader const* header = getMappedArray<map_heightHeader>(offset, 1);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
+        return false;
+
+    _gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
+        {
+            m_uint16_V9 = getMappedArray<uint16>(offset, 129 * 129);
+            m_uint16_V8 = getMappedArray<uint16>(offset, 128 * 128);
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
+            _gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
+        {
+            m_uint8_V9 = getMappedArray<uint8>(offset, 129 * 129);
+            m_uint8_V8 = getMappedArray<uint8>(offset, 128 * 128);
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
+            _gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            m_V9 = getMappedArray<float>(offset, 129 * 129);
+            m_V8 = getMappedArray<float>(offset, 128 * 128);
+            _gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+
+        if (!m_V9 || !m_V8)
+            return false;
+    }
+    else
+        _gridGetHeight = &GridMap::getHeightFromFlat;
+
+    if (header->flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+    {
+        // tiny and not aligned after uint8 heights, always copied
+        if (uint64(offset) + 2 * 3 * 3 * sizeof(int16) > _mappedSize)
+            return false;
+
+        _maxHeight = new int16[3 * 3];
+        _minHeight = new int16[3 * 3];
+        memcpy(_maxHeight, _mappedData + offset, 3 * 3 * sizeof(int16));
+        memcpy(_minHeight, _mappedData + offset + 3 * 3 * sizeof(int16), 3 * 3 * sizeof(int16));
+    }
+
+    return true;
+}
+
+bool GridMap::loadMappedLiquidData(uint32 offset)
+{
+    map_liquidHeader const* header = getMappedArray<map_liquidHeader>(offset, 1);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
+        return false;
+
+    _liquidType   = header->liquidType;
+    _liquidOffX  = header->offsetX;
+    _liquidOffY  = header->offsetY;
+    _liquidWidth = header->width;
+    _liquidHeight = header->height;
+    _liquidLevel  = header->liquidLevel;
+
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
+    {
+        _liquidEntry = getMappedArray<uint16>(offset, 16 * 16);
+        _liquidFlags = getMappedArray<uint8>(offset, 16 * 16);
+        if (!_liquidEntry || !_liquidFlags)
+            return false;
+    }
+
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
+        if (!(_liquidMap = getMappedArray<float>(offset, uint32(_liquidWidth) * uint32(_liquidHeight))))
+            return false;
+
+    return true;
+}
+
 uint16 GridMap::getArea(float x, float y) const
 {
     if (!_areaMap)
@@ -2282,13 +2858,82 @@ float Map::GetWaterLevel(float x, float y) const
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks) const
 {
-    if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2))
-        return false;
+    bool useCache = sWorld->getBoolConfig(CONFIG_VMAP_LOS_CACHE);
+    uint32 generation = _lineOfSightGeneration.load(std::memory_order_relaxed);
+    LineOfSightCache::Key key;
+    if (useCache)
+    {
+        bool inLineOfSight;
+        key = LineOfSightCache::MakeKey(x1, y1, z1, x2, y2, z2, phasemask, checks);
+        if (_lineOfSightCache.Find(key, generation, inLineOfSight))
+            return inLineOfSight;
+    }
 
-    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
+    bool inLineOfSight = true;
+    if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2))
+        inLineOfSight = false;
+    else if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
             && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
-    return true;
+        inLineOfSight = false;
+
+    if (useCache)
+        _lineOfSightCache.Store(key, generation, inLineOfSight);
+
+    return inLineOfSight;
+}
+
+void Map::isInLineOfSight(std::vector<LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks) const
+{
+    bool useCache = sWorld->getBoolConfig(CONFIG_VMAP_LOS_CACHE);
+    uint32 generation = _lineOfSightGeneration.load(std::memory_order_relaxed);
+
+    // queries not answered by the cache
+    std::vector<std::size_t> pending;
+    std::vector<LineOfSightCache::Key> keys;
+    std::vector<G3D::Vector3> starts;
+    std::vector<G3D::Vector3> ends;
+    pending.reserve(queries.size());
+    starts.reserve(queries.size());
+    ends.reserve(queries.size());
+    if (useCache)
+        keys.reserve(queries.size());
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        LineOfSightQuery& query = queries[i];
+        query.InLineOfSight = true;
+        if (useCache)
+        {
+            LineOfSightCache::Key key = LineOfSightCache::MakeKey(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, phasemask, checks);
+            if (_lineOfSightCache.Find(key, generation, query.InLineOfSight))
+                continue;
+
+            keys.push_back(key);
+        }
+
+        pending.push_back(i);
+        starts.emplace_back(query.X1, query.Y1, query.Z1);
+        ends.emplace_back(query.X2, query.Y2, query.Z2);
+    }
+
+    if (pending.empty())
+        return;
+
+    std::unique_ptr<bool[]> results(new bool[pending.size()]);
+    std::fill(results.get(), results.get() + pending.size(), true);
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), starts.data(), ends.data(), results.get(), pending.size());
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+        _dynamicTree.isInLineOfSight(starts.data(), ends.data(), results.get(), pending.size(), phasemask);
+
+    for (std::size_t i = 0; i < pending.size(); ++i)
+    {
+        queries[pending[i]].InLineOfSight = results[i];
+        if (useCache)
+            _lineOfSightCache.Store(keys[i], generation, results[i]);
+    }
 }
 
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -2461,6 +3106,13 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    // the cleanup unlinks other units, which may belong to other regions
+    if (MapRegionContext* context = GetRegionContext())
+    {
+        context->ObjectsToRemove.push_back(obj);
+        return;
+    }
+
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
@@ -2475,6 +3127,12 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    if (MapRegionContext* context = GetRegionContext())
+    {
+        context->ObjectsToSwitch.emplace_back(obj, on);
+        return;
+    }
+
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -3103,21 +3761,25 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto guard = GetRegionUpdateReadGuard();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto guard = GetRegionUpdateReadGuard();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto guard = GetRegionUpdateReadGuard();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto guard = GetRegionUpdateReadGuard();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3132,6 +3794,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = GetRegionUpdateReadGuard();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3154,7 +3817,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = GetRegionUpdateGuard();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3166,7 +3832,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        auto guard = GetRegionUpdateGuard();
+        _creatureRespawnTimes.erase(spawnId);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3188,7 +3857,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = GetRegionUpdateGuard();
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3200,7 +3872,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        auto guard = GetRegionUpdateGuard();
+        _goRespawnTimes.erase(spawnId);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->setUInt32(0, spawnId);
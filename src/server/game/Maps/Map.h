@@ -15,12 +15,17 @@
 #include "GameObjectModel.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
+#include "LineOfSightCache.h"
 #include "MapRefManager.h"
+#include "MapRegionUpdate.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
+#include "PathCache.h"
 #include "PathGenerator.h"
 #include "SharedDefines.h"
 #include "Timer.h"
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <list>
 #include <memory>
@@ -151,6 +156,13 @@ enum LineOfSightChecks
     LINEOFSIGHT_ALL_CHECKS      = (LINEOFSIGHT_CHECK_VMAP | LINEOFSIGHT_CHECK_GOBJECT)
 };
 
+struct LineOfSightQuery
+{
+    float X1, Y1, Z1;
+    float X2, Y2, Z2;
+    bool InLineOfSight = true;
+};
+
 class GridMap
 {
     uint32  _flags;
@@ -191,6 +203,20 @@ class GridMap
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
 
+    // Memory mapped files: the terrain arrays point into the mapping instead of being copied,
+    // the pages are shared through the page cache by every process using the same map files.
+    // The file is closed right after mapping it, loaded grids do not hold file descriptors.
+    uint8* _mappedData;
+    std::size_t _mappedSize;
+    bool mapFile(char const* filename);
+    void unmapFile();
+    bool loadMappedData(char const* filename, map_fileheader const& header);
+    bool loadMappedAreaData(uint32 offset);
+    bool loadMappedHeightData(uint32 offset);
+    bool loadMappedLiquidData(uint32 offset);
+    template<class T>
+    T* getMappedArray(uint32& offset, uint32 count) const;
+
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
     GetHeightPtr _gridGetHeight;
@@ -341,10 +367,33 @@ public:
 
     // pussywizard: movemaps, mmaps
     [[nodiscard]] std::shared_mutex& GetMMapLock() const { return *(const_cast<std::shared_mutex*>(&MMapLock)); }
+    // poly corridors shared by the path searches of the current tick
+    [[nodiscard]] PathCache& GetPathCache() { return _pathCache; }
+    // false if the chase and follow paths allowed for this tick are used up, see MoveMaps.PathBudget
+    [[nodiscard]] bool ConsumePathBudget();
     // pussywizard:
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectForDelayedVisibility(Unit* unit);
     void HandleDelayedVisibility();
 
+    // active cells of large maps can be updated concurrently in independent regions, see MapRegionUpdate.h
+    // map wide containers are modified under the exclusive guard and read under the shared one, both are no-ops outside of region updates
+    [[nodiscard]] std::unique_lock<MapRegionLock> GetRegionUpdateGuard() const
+    {
+        return _regionUpdateInProgress ? std::unique_lock<MapRegionLock>(_regionUpdateLock) : std::unique_lock<MapRegionLock>();
+    }
+    [[nodiscard]] std::shared_lock<MapRegionLock> GetRegionUpdateReadGuard() const
+    {
+        return _regionUpdateInProgress ? std::shared_lock<MapRegionLock>(_regionUpdateLock) : std::shared_lock<MapRegionLock>();
+    }
+    // changes of the region updated by the calling thread, nullptr on the map thread
+    [[nodiscard]] MapRegionContext* GetRegionContext() const;
+    void UpdateRegion(std::vector<uint32> const& cells, MapRegionContext* context, uint32 t_diff);
+
+    // duration of the last threaded update, full (t_diff != 0) and sessions only updates are tracked apart
+    [[nodiscard]] uint32 GetLastUpdateCost(bool full) const { return _lastUpdateCost[full ? 1 : 0]; }
+    void SetLastUpdateCost(bool full, uint32 costUs) { _lastUpdateCost[full ? 1 : 0] = costUs; }
+
     // some calls like isInWater should not use vmaps due to processor power
     // can return INVALID_HEIGHT if under z+2 z coord not found height
     [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
@@ -452,6 +501,8 @@ public:
     DynamicObject* GetDynamicObject(ObjectGuid const guid);
     Pet* GetPet(ObjectGuid const guid);
 
+    // the stores are filled by AddToMap and emptied by RemoveFromMap under the exclusive region guard,
+    // the creatures updated in regions only reach them through the lookups above
     MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
     typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
@@ -490,13 +541,17 @@ public:
     float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks) const;
+    // answers all queries at once, the collision trees are looked up a single time and the results are kept in the line of sight cache
+    void isInLineOfSight(std::vector<LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks) const;
+    // cached line of sight results are dropped, called whenever collision changes
+    void InvalidateLineOfSightCache() { _lineOfSightGeneration.fetch_add(1, std::memory_order_relaxed); }
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
-    void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); InvalidateLineOfSightCache(); }
+    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); InvalidateLineOfSightCache(); }
+    void UpdateGameObjectModel(GameObjectModel& model) { if (_dynamicTree.update(model)) InvalidateLineOfSightCache(); }
     [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
@@ -510,6 +565,7 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(ObjectGuid guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = GetRegionUpdateReadGuard();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -519,6 +575,7 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = GetRegionUpdateReadGuard();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -569,17 +626,24 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        auto guard = GetRegionUpdateGuard();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
-        _updateObjects.insert(obj);
+        if (MapRegionContext* context = GetRegionContext())
+            context->UpdateObjects.emplace_back(obj, true);
+        else
+            _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
-        _updateObjects.erase(obj);
+        if (MapRegionContext* context = GetRegionContext())
+            context->UpdateObjects.emplace_back(obj, false);
+        else
+            _updateObjects.erase(obj);
     }
 
 private:
@@ -620,7 +684,13 @@ private:
     void setNGrid(NGridType* grid, uint32 x, uint32 y);
     void ScriptsProcess();
 
-    void UpdateActiveCells(const float& x, const float& y, const uint32 t_diff);
+    void UpdateActiveCells(uint32 t_diff, uint32 s_diff);
+    [[nodiscard]] bool CanUpdateInRegions() const;
+    void UpdateActiveCellsInRegions(uint32 t_diff, uint32 s_diff);
+    void CollectNearbyCellsOf(WorldObject* obj, MapRegionPartition& partition, std::vector<uint32>& largeCells);
+    void CollectNearbyCellsOfPlayer(Player* player, MapRegionPartition& partition, std::vector<uint32>& largeCells);
+    void UpdateRegions(MapRegionPartition& partition, uint32 t_diff);
+    void MergeRegion(MapRegionContext& context, uint32 t_diff);
 
     void SendObjectUpdates();
 
@@ -628,6 +698,12 @@ protected:
     std::mutex Lock;
     std::mutex GridLock;
     std::shared_mutex MMapLock;
+    PathCache _pathCache;
+    mutable LineOfSightCache _lineOfSightCache;
+    std::atomic<uint32> _lineOfSightGeneration{ 0 };
+    std::atomic<uint32> _pathBudgetUsed{ 0 };
+    mutable MapRegionLock _regionUpdateLock;
+    std::atomic<bool> _regionUpdateInProgress{false};
 
     MapEntry const* i_mapEntry;
     uint8 i_spawnMode;
@@ -636,6 +712,7 @@ protected:
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
     time_t _instanceResetPeriod; // pussywizard
+    std::array<std::atomic<uint32>, 2> _lastUpdateCost{ };
 
     MapRefManager m_mapRefManager;
     MapRefManager::iterator m_mapRefIter;
@@ -684,11 +761,14 @@ private:
 
     void AddToActiveHelper(WorldObject* obj)
     {
+        auto guard = GetRegionUpdateGuard();
         m_activeNonPlayers.insert(obj);
     }
 
     void RemoveFromActiveHelper(WorldObject* obj)
     {
+        auto guard = GetRegionUpdateGuard();
+
         // Map::Update for active object in proccess
         if (m_activeNonPlayersIter != m_activeNonPlayers.end())
         {
@@ -712,13 +792,18 @@ private:
     template<HighGuid high>
     inline ObjectGuidGeneratorBase& GetGuidSequenceGenerator()
     {
+        // all generators are created by the constructor, regions must not insert into the map concurrently
         auto itr = _guidGenerators.find(high);
-        if (itr == _guidGenerators.end())
-            itr = _guidGenerators.insert(std::make_pair(high, std::unique_ptr<ObjectGuidGenerator<high>>(new ObjectGuidGenerator<high>()))).first;
-
+        ASSERT(itr != _guidGenerators.end());
         return *itr->second;
     }
 
+    template<HighGuid high>
+    void CreateGuidSequenceGenerator()
+    {
+        _guidGenerators[high] = std::make_unique<ObjectGuidGenerator<high>>();
+    }
+
     std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
     MapStoredObjectTypesContainer _objectsStore;
     CreatureBySpawnIdContainer _creatureBySpawnIdStore;
@@ -800,8 +885,10 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
 
     if (!cell.NoCreate() || IsGridLoaded(GridCoord(x, y)))
     {
+        // regions only see the grids loaded before they started, see EnsureGridLoaded
         EnsureGridLoaded(cell);
-        getNGrid(x, y)->VisitGrid(cell_x, cell_y, visitor);
+        if (IsGridLoaded(GridCoord(x, y)))
+            getNGrid(x, y)->VisitGrid(cell_x, cell_y, visitor);
     }
 }
 
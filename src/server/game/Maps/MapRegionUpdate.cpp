@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "MapRegionUpdate.h"
+#include "Creature.h"
+#include "DynamicObject.h"
+#include "GameObject.h"
+#include "Map.h"
+#include "SpellAuras.h"
+#include "SpellInfo.h"
+#include <algorithm>
+
+MapRegionPartition::MapRegionPartition(uint32 haloCells) : _bucketSize(std::max<uint32>(haloCells, 1))
+{
+    _bucketsPerAxis = (TOTAL_NUMBER_OF_CELLS_PER_MAP + _bucketSize - 1) / _bucketSize;
+}
+
+uint32 MapRegionPartition::GetCellId(float x, float y)
+{
+    CellCoord coord = Acore::ComputeCellCoord(x, y);
+    return coord.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + coord.x_coord;
+}
+
+uint32 MapRegionPartition::GetBucketId(uint32 cellId) const
+{
+    uint32 x = cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP;
+    uint32 y = cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP;
+    return (y / _bucketSize) * _bucketsPerAxis + x / _bucketSize;
+}
+
+uint32 MapRegionPartition::GetOrCreateNode(uint32 bucketId)
+{
+    auto itr = _nodeByBucket.find(bucketId);
+    if (itr != _nodeByBucket.end())
+        return itr->second;
+
+    uint32 node = _nodeParent.size();
+    _nodeParent.push_back(node);
+    _nodeBucket.push_back(bucketId);
+    _nodeByBucket.emplace(bucketId, node);
+    return node;
+}
+
+uint32 MapRegionPartition::FindRoot(uint32 node)
+{
+    while (_nodeParent[node] != node)
+    {
+        _nodeParent[node] = _nodeParent[_nodeParent[node]];
+        node = _nodeParent[node];
+    }
+
+    return node;
+}
+
+void MapRegionPartition::Union(uint32 nodeA, uint32 nodeB)
+{
+    nodeA = FindRoot(nodeA);
+    nodeB = FindRoot(nodeB);
+    if (nodeA != nodeB)
+        _nodeParent[std::max(nodeA, nodeB)] = std::min(nodeA, nodeB);
+}
+
+void MapRegionPartition::AddCell(uint32 cellId)
+{
+    _cells.emplace_back(cellId, GetOrCreateNode(GetBucketId(cellId)));
+}
+
+void MapRegionPartition::Link(uint32 cellIdA, uint32 cellIdB)
+{
+    _links.emplace_back(cellIdA, cellIdB);
+}
+
+void MapRegionPartition::Build(std::vector<CellList>& regions)
+{
+    regions.clear();
+
+    // merge every bucket with its occupied neighbours, cells of non adjacent buckets are at least _bucketSize + 1 cells apart
+    for (uint32 node = 0; node < _nodeBucket.size(); ++node)
+    {
+        int32 bucketX = _nodeBucket[node] % _bucketsPerAxis;
+        int32 bucketY = _nodeBucket[node] / _bucketsPerAxis;
+
+        for (int32 y = bucketY - 1; y <= bucketY + 1; ++y)
+        {
+            for (int32 x = bucketX - 1; x <= bucketX + 1; ++x)
+            {
+                if (x < 0 || y < 0 || x >= int32(_bucketsPerAxis) || y >= int32(_bucketsPerAxis))
+                    continue;
+
+                auto itr = _nodeByBucket.find(uint32(y) * _bucketsPerAxis + uint32(x));
+                if (itr != _nodeByBucket.end())
+                    Union(node, itr->second);
+            }
+        }
+    }
+
+    for (std::pair<uint32, uint32> const& link : _links)
+    {
+        auto itrA = _nodeByBucket.find(GetBucketId(link.first));
+        auto itrB = _nodeByBucket.find(GetBucketId(link.second));
+        if (itrA != _nodeByBucket.end() && itrB != _nodeByBucket.end())
+            Union(itrA->second, itrB->second);
+    }
+
+    std::unordered_map<uint32 /*root*/, size_t /*region*/> regionByRoot;
+    for (std::pair<uint32, uint32> const& cell : _cells)
+    {
+        uint32 root = FindRoot(cell.second);
+        auto itr = regionByRoot.find(root);
+        if (itr == regionByRoot.end())
+        {
+            itr = regionByRoot.emplace(root, regions.size()).first;
+            regions.emplace_back();
+        }
+
+        regions[itr->second].push_back(cell.first);
+    }
+
+    std::sort(regions.begin(), regions.end(), [](CellList const& left, CellList const& right) { return left.size() > right.size(); });
+}
+
+void MapRegionLock::lock()
+{
+    if (_owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+    {
+        ++_ownerDepth;
+        return;
+    }
+
+    _mutex.lock();
+    _owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    _ownerDepth = 1;
+}
+
+void MapRegionLock::unlock()
+{
+    if (--_ownerDepth)
+        return;
+
+    _owner.store(std::thread::id(), std::memory_order_relaxed);
+    _mutex.unlock();
+}
+
+void MapRegionLock::lock_shared()
+{
+    // the exclusive owner already keeps everybody else out
+    if (_owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+    {
+        ++_ownerDepth;
+        return;
+    }
+
+    _mutex.lock_shared();
+}
+
+void MapRegionLock::unlock_shared()
+{
+    if (_owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+    {
+        --_ownerDepth;
+        return;
+    }
+
+    _mutex.unlock_shared();
+}
+
+bool MapRegionObjectUpdater::CanUpdateInRegion(Creature const* creature, uint32 diff)
+{
+    // respawns, loot rolls, combat and evade all reach other units
+    if (!creature->IsAlive() || creature->IsInCombat() || creature->IsInEvadeMode() || creature->NeedChangeAI)
+        return false;
+
+    if (creature->IsSummon() || creature->GetCharmerOrOwnerGUID() || creature->GetFormation() ||
+        creature->IsVehicle() || creature->GetVehicle() || creature->GetTransport())
+        return false;
+
+    // scripts and script driven AIs may touch anything, the default AIs only act in combat
+    if (creature->GetScriptId() || !creature->GetCreatureTemplate()->AIName.empty())
+        return false;
+
+    // spells and events act on their targets, the AI notify runs the AI of every unit around
+    if (!creature->m_Events.Empty() || creature->IsNonMeleeSpellCast(false) ||
+        (creature->m_delayed_unit_ai_notify_timer && creature->m_delayed_unit_ai_notify_timer <= diff))
+        return false;
+
+    // auras shared with other units update the totals of both sides
+    for (auto const& [spellId, aura] : creature->GetOwnedAuras())
+    {
+        if (aura->GetSpellInfo()->HasAreaAuraEffect())
+            return false;
+
+        for (auto const& [targetGuid, application] : aura->GetApplicationMap())
+            if (targetGuid != creature->GetGUID())
+                return false;
+    }
+
+    for (auto const& [spellId, application] : creature->GetAppliedAuras())
+        if (application->GetBase()->GetCasterGUID() != creature->GetGUID())
+            return false;
+
+    return true;
+}
+
+void MapRegionObjectUpdater::Visit(CreatureMapType& m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end();)
+    {
+        Creature* creature = iter->GetSource();
+        ++iter;
+
+        // large creatures are updated after the merge, like in Map::UpdateActiveCells
+        if (!creature->IsInWorld() || creature->IsVisibilityOverridden())
+            continue;
+
+        if (CanUpdateInRegion(creature, i_timeDiff))
+            creature->Update(i_timeDiff);
+        else
+            i_context.DeferredObjects.push_back(creature->GetGUID());
+    }
+}
+
+void MapRegionObjectUpdater::Visit(GameObjectMapType& m)
+{
+    // gameobjects change the dynamic tree, trigger traps and run scripts
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        if (iter->GetSource()->IsInWorld() && !iter->GetSource()->IsVisibilityOverridden())
+            i_context.DeferredObjects.push_back(iter->GetSource()->GetGUID());
+}
+
+void MapRegionObjectUpdater::Visit(DynamicObjectMapType& m)
+{
+    // dynamic objects apply their auras to the units around
+    for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        if (iter->GetSource()->IsInWorld() && !iter->GetSource()->IsVisibilityOverridden())
+            i_context.DeferredObjects.push_back(iter->GetSource()->GetGUID());
+}
+
+MapRegionUpdateBatch::MapRegionUpdateBatch(Map& map, std::vector<MapRegionPartition::CellList>&& regions, uint32 diff)
+    : _map(map), _regions(std::move(regions)), _diff(diff), _nextRegion(0), _finishedRegions(0)
+{
+    _contexts.reserve(_regions.size());
+    for (size_t i = 0; i < _regions.size(); ++i)
+        _contexts.emplace_back(&_map);
+}
+
+void MapRegionUpdateBatch::Process()
+{
+    size_t region;
+    while ((region = _nextRegion++) < _regions.size())
+    {
+        _map.UpdateRegion(_regions[region], &_contexts[region], _diff);
+
+        std::lock_guard<std::mutex> guard(_lock);
+        if (++_finishedRegions == _regions.size())
+            _condition.notify_all();
+    }
+}
+
+void MapRegionUpdateBatch::Wait()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+
+    while (_finishedRegions < _regions.size())
+        _condition.wait(guard);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _MAP_REGION_UPDATE_H_INCLUDED
+#define _MAP_REGION_UPDATE_H_INCLUDED
+
+#include "Cell.h"
+#include "Define.h"
+#include "GridDefines.h"
+#include "ObjectDefines.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Creature;
+class DynamicObject;
+class GameObject;
+class Map;
+class Object;
+class Unit;
+class WorldObject;
+
+// cells of two different regions are always more than this amount of cells apart,
+// so objects of different regions can not see or reach each other
+#define MAP_REGION_HALO_CELLS uint32(MAX_VISIBILITY_DISTANCE / SIZE_OF_GRID_CELL + 1)
+
+// Splits the active cells of a map into independent regions.
+// Cells are grouped into square buckets of haloCells size, occupied neighbour buckets always end up in the same region
+class MapRegionPartition
+{
+public:
+    typedef std::vector<uint32> CellList;
+
+    explicit MapRegionPartition(uint32 haloCells);
+
+    void AddCell(uint32 cellId);
+    // forces both cells into the same region, used for interactions longer than the halo (e.g. creatures in combat with far players)
+    void Link(uint32 cellIdA, uint32 cellIdB);
+    // regions are sorted by cell count, largest first
+    void Build(std::vector<CellList>& regions);
+
+    static uint32 GetCellId(float x, float y);
+
+private:
+    uint32 GetBucketId(uint32 cellId) const;
+    uint32 GetOrCreateNode(uint32 bucketId);
+    uint32 FindRoot(uint32 node);
+    void Union(uint32 nodeA, uint32 nodeB);
+
+    uint32 _bucketSize;
+    uint32 _bucketsPerAxis;
+    std::unordered_map<uint32 /*bucketId*/, uint32 /*node*/> _nodeByBucket;
+    std::vector<uint32> _nodeParent;
+    std::vector<uint32> _nodeBucket;
+    std::vector<std::pair<uint32 /*cellId*/, uint32 /*node*/>> _cells;
+    std::vector<std::pair<uint32, uint32>> _links;
+};
+
+// Shared mutex the exclusive owner may enter again, exclusively or shared.
+// Regions only read the map wide object stores, so lookups of different regions do not serialize.
+class MapRegionLock
+{
+public:
+    void lock();
+    void unlock();
+    void lock_shared();
+    void unlock_shared();
+
+private:
+    std::shared_mutex _mutex;
+    std::atomic<std::thread::id> _owner;
+    uint32 _ownerDepth = 0;
+};
+
+// Changes a region makes to map wide state. They are applied on the map thread, in region order, once all regions are done.
+struct MapRegionContext
+{
+    explicit MapRegionContext(Map const* map) : Owner(map) { }
+
+    Map const* Owner;
+
+    // objects whose update may reach beyond their region, updated on the map thread
+    std::vector<ObjectGuid> DeferredObjects;
+    // grids are never loaded from inside a region
+    std::vector<Cell> GridsToLoad;
+
+    std::vector<std::pair<Object*, bool /*add*/>> UpdateObjects;
+    std::vector<Unit*> DelayedVisibility;
+    std::vector<Creature*> CreaturesToMove;
+    std::vector<GameObject*> GameObjectsToMove;
+    std::vector<DynamicObject*> DynamicObjectsToMove;
+    std::vector<std::pair<WorldObject*, bool /*on*/>> ObjectsToSwitch;
+    std::vector<WorldObject*> ObjectsToRemove;
+};
+
+// Updates the grid objects of one region, objects which are not safe to update off the map thread are deferred
+struct MapRegionObjectUpdater
+{
+    MapRegionObjectUpdater(MapRegionContext& context, uint32 diff) : i_context(context), i_timeDiff(diff) { }
+
+    void Visit(CreatureMapType& m);
+    void Visit(GameObjectMapType& m);
+    void Visit(DynamicObjectMapType& m);
+    void Visit(PlayerMapType&) { }
+    void Visit(CorpseMapType&) { }
+
+    // true if the update of the creature only changes the creature itself and its own cells
+    static bool CanUpdateInRegion(Creature const* creature, uint32 diff);
+
+    MapRegionContext& i_context;
+    uint32 i_timeDiff;
+};
+
+// All region updates of one map tick, shared between the map thread and the MapUpdater workers helping it
+class MapRegionUpdateBatch
+{
+public:
+    MapRegionUpdateBatch(Map& map, std::vector<MapRegionPartition::CellList>&& regions, uint32 diff);
+
+    // claims and updates regions until every region has been claimed
+    void Process();
+    // blocks until all claimed regions are updated
+    void Wait();
+
+    [[nodiscard]] size_t GetRegionCount() const { return _regions.size(); }
+    // only valid after Wait
+    [[nodiscard]] std::vector<MapRegionContext>& GetContexts() { return _contexts; }
+
+private:
+    Map& _map;
+    std::vector<MapRegionPartition::CellList> _regions;
+    std::vector<MapRegionContext> _contexts;
+    uint32 _diff;
+
+    std::atomic<size_t> _nextRegion;
+    size_t _finishedRegions;
+    std::mutex _lock;
+    std::condition_variable _condition;
+};
+
+#endif //_MAP_REGION_UPDATE_H_INCLUDED
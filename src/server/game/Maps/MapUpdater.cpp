@@ -7,7 +7,9 @@
 #include "AvgDiffTracker.h"
 #include "LFGMgr.h"
 #include "Map.h"
+#include "MapRegionUpdate.h"
 #include "MapUpdater.h"
+#include <limits>
 
 class UpdateRequest
 {
@@ -28,7 +30,9 @@ public:
 
     void call() override
     {
+        TimePoint start = std::chrono::steady_clock::now();
         m_map.Update(m_diff, s_diff);
+        m_map.SetLastUpdateCost(m_diff != 0, uint32(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start).count()));
         m_updater.update_finished();
     }
 private:
@@ -56,7 +60,31 @@ private:
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater(): pending_requests(0)
+class MapRegionUpdateRequest : public UpdateRequest
+{
+public:
+    MapRegionUpdateRequest(std::shared_ptr<MapRegionUpdateBatch> batch, MapUpdater& u)
+        : m_batch(std::move(batch)), m_updater(u)
+    {
+    }
+
+    void call() override
+    {
+        m_batch->Process();
+        m_updater.update_finished();
+    }
+private:
+    std::shared_ptr<MapRegionUpdateBatch> m_batch;
+    MapUpdater& m_updater;
+};
+
+namespace
+{
+    // requests that have to start before any map: LFG runs next to the maps and the others schedule more work
+    constexpr uint64 MAP_UPDATER_COST_FIRST = std::numeric_limits<uint64>::max();
+}
+
+MapUpdater::MapUpdater(): _cancelationToken(false), _queueSequence(0), pending_requests(0)
 {
 }
 
@@ -79,7 +107,16 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        while (!_queue.empty())
+        {
+            delete _queue.top().Request;
+            _queue.pop();
+        }
+    }
+
+    _queueCondition.notify_all();
 
     for (auto& thread : _workerThreads)
     {
@@ -103,7 +140,10 @@ void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 
     ++pending_requests;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+    // instanced parents only schedule their instances (instance id 0 is the MapInstanced itself)
+    bool instancedParent = map.Instanceable() && !map.GetInstanceId();
+    uint64 cost = instancedParent ? MAP_UPDATER_COST_FIRST : map.GetLastUpdateCost(diff != 0);
+    Enqueue(new MapUpdateRequest(map, *this, diff, s_diff), cost);
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
@@ -112,7 +152,26 @@ void MapUpdater::schedule_lfg_update(uint32 diff)
 
     ++pending_requests;
 
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+    Enqueue(new LFGUpdateRequest(*this, diff), MAP_UPDATER_COST_FIRST);
+}
+
+void MapUpdater::schedule_region_update(std::shared_ptr<MapRegionUpdateBatch> batch)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    ++pending_requests;
+
+    Enqueue(new MapRegionUpdateRequest(std::move(batch), *this), MAP_UPDATER_COST_FIRST);
+}
+
+void MapUpdater::Enqueue(UpdateRequest* request, uint64 cost)
+{
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _queue.push({ request, cost, _queueSequence++ });
+    }
+
+    _queueCondition.notify_one();
 }
 
 bool MapUpdater::activated()
@@ -135,9 +194,16 @@ void MapUpdater::WorkerThread()
     {
         UpdateRequest* request = nullptr;
 
-        _queue.WaitAndPop(request);
-        if (_cancelationToken)
-            return;
+        {
+            std::unique_lock<std::mutex> guard(_queueLock);
+            _queueCondition.wait(guard, [this] { return !_queue.empty() || _cancelationToken; });
+
+            if (_cancelationToken)
+                return;
+
+            request = _queue.top().Request;
+            _queue.pop();
+        }
 
         request->call();
 
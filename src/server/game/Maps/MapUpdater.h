@@ -2,12 +2,16 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <queue>
 #include <thread>
+#include <vector>
 
 class Map;
+class MapRegionUpdateBatch;
 class UpdateRequest;
 
 class MapUpdater
@@ -18,6 +22,7 @@ public:
 
     void schedule_update(Map& map, uint32 diff, uint32 s_diff);
     void schedule_lfg_update(uint32 diff);
+    void schedule_region_update(std::shared_ptr<MapRegionUpdateBatch> batch);
     void wait();
     void activate(size_t num_threads);
     void deactivate();
@@ -25,9 +30,29 @@ public:
     void update_finished();
 
 private:
+    // requests are started most expensive first, the cost of a map is the duration of its previous update
+    struct QueuedRequest
+    {
+        UpdateRequest* Request;
+        uint64 Cost;
+        uint64 Sequence;
+
+        bool operator<(QueuedRequest const& right) const
+        {
+            // std::priority_queue pops the largest element: highest cost first, then oldest
+            if (Cost != right.Cost)
+                return Cost < right.Cost;
+            return Sequence > right.Sequence;
+        }
+    };
+
     void WorkerThread();
+    void Enqueue(UpdateRequest* request, uint64 cost);
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    std::priority_queue<QueuedRequest> _queue;
+    std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    uint64 _queueSequence;
 
     std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "UpdateProfiler.h"
+#include <algorithm>
+
+namespace
+{
+    struct UpdateProfilerSectionInfo
+    {
+        char const* Name;
+        UpdateProfilerSection Parent;
+    };
+
+    // sections without a parent point to themselves
+    std::array<UpdateProfilerSectionInfo, MAX_UPDATE_SECTIONS> const SectionInfo =
+    { {
+        { "World::Update",          UPDATE_SECTION_WORLD },
+        { "Sessions",               UPDATE_SECTION_WORLD },
+        { "LFG",                    UPDATE_SECTION_WORLD },
+        { "Maps",                   UPDATE_SECTION_WORLD },
+        { "Battlegrounds",          UPDATE_SECTION_WORLD },
+        { "OutdoorPvP",             UPDATE_SECTION_WORLD },
+        { "Query callbacks",        UPDATE_SECTION_WORLD },
+        { "Game events",            UPDATE_SECTION_WORLD },
+        { "Instance resets",        UPDATE_SECTION_WORLD },
+        { "CLI commands",           UPDATE_SECTION_WORLD },
+        { "World scripts",          UPDATE_SECTION_WORLD },
+        { "Map::Update",            UPDATE_SECTION_MAP },
+        { "Sessions",               UPDATE_SECTION_MAP },
+        { "Active cells",           UPDATE_SECTION_MAP },
+        { "Transports",             UPDATE_SECTION_MAP },
+        { "Object updates",         UPDATE_SECTION_MAP },
+        { "Scripts",                UPDATE_SECTION_MAP },
+        { "Move lists",             UPDATE_SECTION_MAP },
+        { "Visibility",             UPDATE_SECTION_MAP },
+    } };
+
+    std::array<uint32, MAX_UPDATE_PROFILER_BUCKETS> const BucketLimitsUs =
+    {
+        100, 1000, 10000, 50000, 100000, 0
+    };
+}
+
+UpdateProfiler* UpdateProfiler::instance()
+{
+    static UpdateProfiler instance;
+    return &instance;
+}
+
+void UpdateProfiler::Record(UpdateProfilerSection section, Microseconds duration)
+{
+    if (section >= MAX_UPDATE_SECTIONS)
+        return;
+
+    Record(_sections[section], uint64(std::max<int64>(duration.count(), 0)));
+}
+
+void UpdateProfiler::RecordMap(uint32 mapId, Microseconds duration)
+{
+    std::lock_guard<std::mutex> guard(_mapsLock);
+    Record(_maps[mapId], uint64(std::max<int64>(duration.count(), 0)));
+}
+
+void UpdateProfiler::Reset()
+{
+    for (Counters& counters : _sections)
+        Reset(counters);
+
+    std::lock_guard<std::mutex> guard(_mapsLock);
+    for (auto& [mapId, counters] : _maps)
+        Reset(counters);
+}
+
+UpdateProfilerEntry UpdateProfiler::GetStats(UpdateProfilerSection section) const
+{
+    UpdateProfilerEntry entry;
+    if (section < MAX_UPDATE_SECTIONS)
+        Fill(entry, _sections[section]);
+
+    return entry;
+}
+
+std::vector<UpdateProfilerMapEntry> UpdateProfiler::GetTopMaps(std::size_t count) const
+{
+    std::vector<UpdateProfilerMapEntry> entries;
+    {
+        std::lock_guard<std::mutex> guard(_mapsLock);
+        for (auto const& [mapId, counters] : _maps)
+        {
+            if (!counters.Count.load(std::memory_order_relaxed))
+                continue;
+
+            UpdateProfilerMapEntry& entry = entries.emplace_back();
+            entry.MapId = mapId;
+            Fill(entry, counters);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](UpdateProfilerMapEntry const& left, UpdateProfilerMapEntry const& right)
+    {
+        return left.TotalUs > right.TotalUs;
+    });
+
+    if (entries.size() > count)
+        entries.resize(count);
+
+    return entries;
+}
+
+char const* UpdateProfiler::GetSectionName(UpdateProfilerSection section)
+{
+    return section < MAX_UPDATE_SECTIONS ? SectionInfo[section].Name : "Unknown";
+}
+
+UpdateProfilerSection UpdateProfiler::GetParentSection(UpdateProfilerSection section)
+{
+    return section < MAX_UPDATE_SECTIONS ? SectionInfo[section].Parent : section;
+}
+
+uint32 UpdateProfiler::GetBucketLimitUs(UpdateProfilerBucket bucket)
+{
+    return bucket < MAX_UPDATE_PROFILER_BUCKETS ? BucketLimitsUs[bucket] : 0;
+}
+
+void UpdateProfiler::Record(Counters& counters, uint64 us)
+{
+    uint32 bucket = UPDATE_PROFILER_BUCKET_100US;
+    while (bucket < UPDATE_PROFILER_BUCKET_SLOW && us >= BucketLimitsUs[bucket])
+        ++bucket;
+
+    counters.Count.fetch_add(1, std::memory_order_relaxed);
+    counters.TotalUs.fetch_add(us, std::memory_order_relaxed);
+    counters.Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint64 max = counters.MaxUs.load(std::memory_order_relaxed);
+    while (us > max && !counters.MaxUs.compare_exchange_weak(max, us, std::memory_order_relaxed));
+}
+
+void UpdateProfiler::Reset(Counters& counters)
+{
+    counters.Count.store(0, std::memory_order_relaxed);
+    counters.TotalUs.store(0, std::memory_order_relaxed);
+    counters.MaxUs.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64>& bucket : counters.Buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void UpdateProfiler::Fill(UpdateProfilerEntry& entry, Counters const& counters)
+{
+    entry.Count = counters.Count.load(std::memory_order_relaxed);
+    entry.TotalUs = counters.TotalUs.load(std::memory_order_relaxed);
+    entry.MaxUs = counters.MaxUs.load(std::memory_order_relaxed);
+    for (uint32 i = 0; i < MAX_UPDATE_PROFILER_BUCKETS; ++i)
+        entry.Buckets[i] = counters.Buckets[i].load(std::memory_order_relaxed);
+}
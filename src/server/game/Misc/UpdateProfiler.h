@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_UPDATEPROFILER_H
+#define ACORE_UPDATEPROFILER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum UpdateProfilerSection
+{
+    UPDATE_SECTION_WORLD,                   // World::Update
+    UPDATE_SECTION_WORLD_SESSIONS,          // World::UpdateSessions, auctions and mail expiration (auction listing lock held)
+    UPDATE_SECTION_WORLD_LFG,               // sLFGMgr->Update before and after the maps
+    UPDATE_SECTION_WORLD_MAPS,              // sMapMgr->Update, wall time of all map threads
+    UPDATE_SECTION_WORLD_BATTLEGROUNDS,     // sBattlegroundMgr->Update
+    UPDATE_SECTION_WORLD_OUTDOORPVP,        // sOutdoorPvPMgr->Update and sBattlefieldMgr->Update
+    UPDATE_SECTION_WORLD_QUERY_CALLBACKS,   // World::ProcessQueryCallbacks
+    UPDATE_SECTION_WORLD_GAME_EVENTS,       // sGameEventMgr->Update
+    UPDATE_SECTION_WORLD_INSTANCE_RESETS,   // sInstanceSaveMgr->Update
+    UPDATE_SECTION_WORLD_CLI_COMMANDS,      // World::ProcessCliCommands
+    UPDATE_SECTION_WORLD_SCRIPTS,           // OnWorldUpdate hooks
+    UPDATE_SECTION_MAP,                     // Map::Update, summed over all maps and map threads
+    UPDATE_SECTION_MAP_SESSIONS,            // packets of the players on the map
+    UPDATE_SECTION_MAP_CELLS,               // players and the objects in the active cells
+    UPDATE_SECTION_MAP_TRANSPORTS,          // motion transports
+    UPDATE_SECTION_MAP_OBJECT_UPDATES,      // Map::SendObjectUpdates
+    UPDATE_SECTION_MAP_SCRIPTS,             // Map::ScriptsProcess
+    UPDATE_SECTION_MAP_MOVE_LISTS,          // relocations delayed during the cell update
+    UPDATE_SECTION_MAP_VISIBILITY,          // Map::HandleDelayedVisibility
+
+    MAX_UPDATE_SECTIONS
+};
+
+enum UpdateProfilerBucket
+{
+    UPDATE_PROFILER_BUCKET_100US,       // < 100us
+    UPDATE_PROFILER_BUCKET_1MS,         // < 1ms
+    UPDATE_PROFILER_BUCKET_10MS,        // < 10ms
+    UPDATE_PROFILER_BUCKET_50MS,        // < 50ms
+    UPDATE_PROFILER_BUCKET_100MS,       // < 100ms
+    UPDATE_PROFILER_BUCKET_SLOW,        // >= 100ms
+
+    MAX_UPDATE_PROFILER_BUCKETS
+};
+
+struct UpdateProfilerEntry
+{
+    uint64 Count = 0;
+    uint64 TotalUs = 0;
+    uint64 MaxUs = 0;
+    std::array<uint64, MAX_UPDATE_PROFILER_BUCKETS> Buckets = { };
+};
+
+struct UpdateProfilerMapEntry : public UpdateProfilerEntry
+{
+    uint32 MapId = 0;
+};
+
+/// Time histograms of the world and map update phases.
+/// Disabled by default, a disabled profiler costs one relaxed atomic load per section.
+class UpdateProfiler
+{
+private:
+    UpdateProfiler() : _enabled(false) { }
+    ~UpdateProfiler() = default;
+
+public:
+    static UpdateProfiler* instance();
+
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    void Record(UpdateProfilerSection section, Microseconds duration);
+    void RecordMap(uint32 mapId, Microseconds duration);
+    void Reset();
+
+    UpdateProfilerEntry GetStats(UpdateProfilerSection section) const;
+    /// Maps with the highest total update time first
+    std::vector<UpdateProfilerMapEntry> GetTopMaps(std::size_t count) const;
+
+    static char const* GetSectionName(UpdateProfilerSection section);
+    static UpdateProfilerSection GetParentSection(UpdateProfilerSection section);
+    static uint32 GetBucketLimitUs(UpdateProfilerBucket bucket);
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64> Count{ 0 };
+        std::atomic<uint64> TotalUs{ 0 };
+        std::atomic<uint64> MaxUs{ 0 };
+        std::array<std::atomic<uint64>, MAX_UPDATE_PROFILER_BUCKETS> Buckets{ };
+    };
+
+    static void Record(Counters& counters, uint64 us);
+    static void Reset(Counters& counters);
+    static void Fill(UpdateProfilerEntry& entry, Counters const& counters);
+
+    std::atomic<bool> _enabled;
+    std::array<Counters, MAX_UPDATE_SECTIONS> _sections;
+
+    mutable std::mutex _mapsLock;
+    std::unordered_map<uint32, Counters> _maps;
+};
+
+#define sUpdateProfiler UpdateProfiler::instance()
+
+/// Times the enclosing block if the profiler is enabled when the block is entered
+class UpdateProfilerScope
+{
+public:
+    explicit UpdateProfilerScope(UpdateProfilerSection section, uint32 mapId = 0) :
+        _section(section), _mapId(mapId), _enabled(sUpdateProfiler->IsEnabled())
+    {
+        if (_enabled)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    ~UpdateProfilerScope()
+    {
+        if (!_enabled)
+            return;
+
+        Microseconds duration = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start);
+        sUpdateProfiler->Record(_section, duration);
+        if (_section == UPDATE_SECTION_MAP)
+            sUpdateProfiler->RecordMap(_mapId, duration);
+    }
+
+    UpdateProfilerScope(UpdateProfilerScope const&) = delete;
+    UpdateProfilerScope& operator=(UpdateProfilerScope const&) = delete;
+
+private:
+    UpdateProfilerSection _section;
+    uint32 _mapId;
+    bool _enabled;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#endif
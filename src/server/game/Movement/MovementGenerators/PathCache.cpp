@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PathCache.h"
+#include "DetourNavMeshQuery.h"
+#include <algorithm>
+
+std::size_t PathCache::KeyHash::operator()(Key const& key) const
+{
+    std::hash<dtPolyRef> hasher;
+    std::size_t hash = hasher(key.StartPoly);
+    hash ^= hasher(key.EndPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::size_t(key.IncludeFlags | (key.ExcludeFlags << 16)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+PathCache::Key PathCache::MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter)
+{
+    return { startPoly, endPoly, filter.getIncludeFlags(), filter.getExcludeFlags() };
+}
+
+void PathCache::CheckGeneration(uint32 generation)
+{
+    if (_generation == generation)
+        return;
+
+    _corridors.clear();
+    _generation = generation;
+}
+
+bool PathCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 generation, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    CheckGeneration(generation);
+
+    auto itr = _corridors.find(MakeKey(startPoly, endPoly, filter));
+    if (itr == _corridors.end() || itr->second.size() > maxPathLength)
+    {
+        ++_stats.Misses;
+        return false;
+    }
+
+    std::copy(itr->second.begin(), itr->second.end(), path);
+    pathLength = uint32(itr->second.size());
+    ++_stats.Hits;
+    return true;
+}
+
+void PathCache::Store(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 generation, dtPolyRef const* path, uint32 pathLength)
+{
+    if (!pathLength)
+        return;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    CheckGeneration(generation);
+
+    if (_corridors.size() >= PATH_CACHE_MAX_ENTRIES)
+        return;
+
+    _corridors[MakeKey(startPoly, endPoly, filter)].assign(path, path + pathLength);
+}
+
+void PathCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _corridors.clear();
+}
+
+PathCacheStats PathCache::GetStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _stats;
+}
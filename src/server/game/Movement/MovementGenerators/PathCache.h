@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class dtQueryFilter;
+
+#define PATH_CACHE_MAX_ENTRIES  512
+
+struct PathCacheStats
+{
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+};
+
+// Poly corridors found during the current map tick.
+// Creatures chasing the same target usually start on a handful of polygons and end on the target's polygon,
+// so the first of them runs the A* search and the others reuse its corridor instead of searching again.
+// Only the corridor is shared, every creature still builds its own point path from its exact position.
+class PathCache
+{
+public:
+    PathCache() : _generation(0) { }
+
+    // copies the cached corridor into path, false if it is unknown or longer than maxPathLength
+    bool Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 generation, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+    void Store(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 generation, dtPolyRef const* path, uint32 pathLength);
+
+    // called at the start of every map tick, positions and navmesh tiles may have changed since the corridors were found
+    void Clear();
+
+    [[nodiscard]] PathCacheStats GetStats() const;
+
+private:
+    struct Key
+    {
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+
+        bool operator==(Key const& right) const
+        {
+            return StartPoly == right.StartPoly && EndPoly == right.EndPoly && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    static Key MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter);
+    // drops the corridors of an older navmesh generation, _lock must be held
+    void CheckGeneration(uint32 generation);
+
+    // region updates of the same map search paths concurrently
+    mutable std::mutex _lock;
+    std::unordered_map<Key, std::vector<dtPolyRef>, KeyHash> _corridors;
+    uint32 _generation;
+    PathCacheStats _stats;
+};
+
+#endif
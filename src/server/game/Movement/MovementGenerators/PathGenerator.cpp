@@ -13,6 +13,7 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "PathGenerator.h"
+#include "PathSearchPool.h"
 
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
@@ -28,7 +29,6 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
     }
 
     CreateFilter();
@@ -59,6 +59,10 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     _forceDestination = forceDest;
 
+    // queries belong to the thread using them and a map may be updated by a different thread every tick
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    _navMeshQuery = _navMesh ? mmap->GetNavMeshQuery(_source->GetMapId()) : nullptr;
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
@@ -76,6 +80,55 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
     return true;
 }
 
+bool PathGenerator::PrepareCorridor(float destX, float destY, float destZ)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    uint32 mapId = _source->GetMapId();
+
+    if (_corridorSearch)
+    {
+        if (!_corridorSearch->Done.load(std::memory_order_acquire))
+            return false;
+
+        std::shared_ptr<PathSearch> search = std::move(_corridorSearch);
+
+        // poly refs of a failed search or of an older navmesh generation are dropped, CalculatePath searches on its own then
+        if (!search->Corridor.empty() && search->Generation == mmap->GetNavMeshGeneration(mapId))
+        {
+            _polyLength = search->Corridor.size();
+            std::copy(search->Corridor.begin(), search->Corridor.end(), _pathPolyRefs);
+        }
+
+        return true;
+    }
+
+    Unit const* _sourceUnit = _source->ToUnit();
+    if (!sPathSearchPool->IsActive() || !_navMesh || _useRaycast || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)))
+        return true;
+
+    G3D::Vector3 start(_source->GetPositionX(), _source->GetPositionY(), _source->GetPositionZ());
+    G3D::Vector3 dest(destX, destY, destZ);
+    if (!Acore::IsValidMapCoord(destX, destY, destZ) || !HaveTile(start) || !HaveTile(dest))
+        return true;
+
+    _navMeshQuery = mmap->GetNavMeshQuery(mapId);
+    if (!_navMeshQuery)
+        return true;
+
+    // both ends are still on the current corridor, CalculatePath only cuts it
+    float startPoint[VERTEX_SIZE] = { start.y, start.z, start.x };
+    float endPoint[VERTEX_SIZE] = { dest.y, dest.z, dest.x };
+    if (GetPathPolyByPosition(_pathPolyRefs, _polyLength, startPoint) != INVALID_POLYREF &&
+        GetPathPolyByPosition(_pathPolyRefs, _polyLength, endPoint) != INVALID_POLYREF)
+        return true;
+
+    UpdateFilter();
+
+    _corridorSearch = std::make_shared<PathSearch>(mapId, start, dest, _filter.getIncludeFlags(), _filter.getExcludeFlags(), mmap->GetNavMeshGeneration(mapId));
+    sPathSearchPool->Submit(_corridorSearch);
+    return false;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -456,15 +509,26 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &_filter,           // polygon search filter
-                _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
+            // creatures chasing the same target mostly search the same corridor within one tick
+            PathCache& pathCache = _source->GetMap()->GetPathCache();
+            uint32 generation = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshGeneration(_source->GetMapId());
+            if (pathCache.Find(startPoly, endPoly, _filter, generation, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                    startPoly,          // start polygon
+                    endPoly,            // end polygon
+                    startPoint,         // start position
+                    endPoint,           // end position
+                    &_filter,           // polygon search filter
+                    _pathPolyRefs,     // [out] path
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                if (dtStatusSucceed(dtResult))
+                    pathCache.Store(startPoly, endPoly, _filter, generation, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -15,9 +15,11 @@
 #include "MoveSplineInitArgs.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
+#include <memory>
 
 class Unit;
 class WorldObject;
+struct PathSearch;
 
 // 74*4.0f=296y number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -55,6 +57,9 @@ class PathGenerator
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
         bool CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+        // With MoveMaps.PathThreads, searches a new poly corridor on the path search pool if the current one does not
+        // lead from the owner to the destination. False while that search runs; CalculatePath then reuses the corridor.
+        bool PrepareCorridor(float destX, float destY, float destZ);
         [[nodiscard]] bool IsInvalidDestinationZ(Unit const* target) const;
         [[nodiscard]] bool IsWalkableClimb(float const* v1, float const* v2) const;
         [[nodiscard]] bool IsWalkableClimb(float x, float y, float z, float destX, float destY, float destZ) const;
@@ -134,6 +139,8 @@ class PathGenerator
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
+        std::shared_ptr<PathSearch> _corridorSearch;    // background corridor search, see PrepareCorridor
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
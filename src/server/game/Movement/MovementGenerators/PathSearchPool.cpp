@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PathSearchPool.h"
+#include "DetourExtended.h"
+#include "DetourNavMeshQuery.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "PathGenerator.h"
+
+PathSearchPool* PathSearchPool::instance()
+{
+    static PathSearchPool instance;
+    return &instance;
+}
+
+void PathSearchPool::Start(uint32 threads)
+{
+    for (uint32 i = 0; i < threads; ++i)
+        _threads.emplace_back(&PathSearchPool::WorkerThread, this);
+}
+
+void PathSearchPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _stopping = true;
+    }
+
+    _queueCondition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+
+    _threads.clear();
+
+    // searches still queued are never finished, their generators gave up on them with the map
+    std::queue<std::shared_ptr<PathSearch>>().swap(_queue);
+}
+
+void PathSearchPool::Submit(std::shared_ptr<PathSearch> search)
+{
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _queue.push(std::move(search));
+    }
+
+    _queueCondition.notify_one();
+}
+
+void PathSearchPool::WorkerThread()
+{
+    while (true)
+    {
+        std::shared_ptr<PathSearch> search;
+
+        {
+            std::unique_lock<std::mutex> guard(_queueLock);
+            _queueCondition.wait(guard, [this] { return !_queue.empty() || _stopping; });
+            if (_stopping)
+                return;
+
+            search = std::move(_queue.front());
+            _queue.pop();
+        }
+
+        // the generator may have been destroyed meanwhile, nobody waits for this result anymore
+        if (search.use_count() > 1)
+            Search(*search);
+
+        search->Done.store(true, std::memory_order_release);
+    }
+}
+
+void PathSearchPool::Search(PathSearch& search)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    std::shared_lock<std::shared_mutex> tilesGuard = mmap->LockTiles(search.MapId);
+    if (!tilesGuard.owns_lock() || mmap->GetNavMeshGeneration(search.MapId) != search.Generation)
+        return;
+
+    dtNavMeshQuery const* query = mmap->GetNavMeshQuery(search.MapId);
+    if (!query)
+        return;
+
+    dtQueryFilterExt filter;
+    filter.setIncludeFlags(search.IncludeFlags);
+    filter.setExcludeFlags(search.ExcludeFlags);
+
+    // same search boxes as PathGenerator::GetPolyByLocation
+    auto findPoly = [query, &filter](float const* point) -> dtPolyRef
+    {
+        float extents[VERTEX_SIZE] = { 3.0f, 5.0f, 3.0f };
+        float closestPoint[VERTEX_SIZE];
+        dtPolyRef polyRef = INVALID_POLYREF;
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, &filter, &polyRef, closestPoint)) && polyRef != INVALID_POLYREF)
+            return polyRef;
+
+        extents[1] = 50.0f;
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, &filter, &polyRef, closestPoint)))
+            return polyRef;
+
+        return INVALID_POLYREF;
+    };
+
+    float startPoint[VERTEX_SIZE] = { search.Start.y, search.Start.z, search.Start.x };
+    float endPoint[VERTEX_SIZE] = { search.End.y, search.End.z, search.End.x };
+
+    dtPolyRef startPoly = findPoly(startPoint);
+    dtPolyRef endPoly = findPoly(endPoint);
+    if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF)
+        return;
+
+    dtPolyRef corridor[MAX_PATH_LENGTH];
+    int corridorLength = 0;
+    if (dtStatusFailed(query->findPath(startPoly, endPoly, startPoint, endPoint, &filter, corridor, &corridorLength, MAX_PATH_LENGTH)))
+        return;
+
+    search.Corridor.assign(corridor, corridor + corridorLength);
+}
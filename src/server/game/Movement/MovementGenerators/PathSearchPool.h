@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PATH_SEARCH_POOL_H
+#define _PATH_SEARCH_POOL_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <G3D/Vector3.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// A poly corridor search handed to the pool. The map thread fills the request, a pool thread the result.
+// Only the navmesh is read off the map thread, everything depending on units or terrain stays in PathGenerator.
+struct PathSearch
+{
+    PathSearch(uint32 mapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint16 includeFlags, uint16 excludeFlags, uint32 generation)
+        : MapId(mapId), Start(start), End(end), IncludeFlags(includeFlags), ExcludeFlags(excludeFlags), Generation(generation), Done(false) { }
+
+    uint32 const MapId;
+    G3D::Vector3 const Start;
+    G3D::Vector3 const End;
+    uint16 const IncludeFlags;
+    uint16 const ExcludeFlags;
+    uint32 const Generation;        // navmesh generation the corridor is valid for
+
+    // result, only read once Done is set
+    std::vector<dtPolyRef> Corridor;
+    std::atomic<bool> Done;
+};
+
+class PathSearchPool
+{
+public:
+    static PathSearchPool* instance();
+
+    void Start(uint32 threads);
+    void Stop();
+    [[nodiscard]] bool IsActive() const { return !_threads.empty(); }
+
+    void Submit(std::shared_ptr<PathSearch> search);
+
+private:
+    PathSearchPool() : _stopping(false) { }
+    ~PathSearchPool() { Stop(); }
+
+    void WorkerThread();
+    static void Search(PathSearch& search);
+
+    std::vector<std::thread> _threads;
+    std::queue<std::shared_ptr<PathSearch>> _queue;
+    std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    bool _stopping;
+};
+
+#define sPathSearchPool PathSearchPool::instance()
+
+#endif
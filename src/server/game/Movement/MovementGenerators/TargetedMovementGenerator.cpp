@@ -151,6 +151,22 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     if (owner->IsHovering())
         owner->UpdateAllowedPositionZ(x, y, z);
 
+    // a new corridor is searched in the background, keep the current spline until a later update picks it up
+    if (!i_path->PrepareCorridor(x, y, z))
+    {
+        _lastTargetPosition.reset();
+        return true;
+    }
+
+    // the map ran out of paths for this tick, keep the current spline and retry on the next one without the budget check
+    if (!_pathDeferred && !owner->GetMap()->ConsumePathBudget())
+    {
+        _pathDeferred = true;
+        _lastTargetPosition.reset();
+        return true;
+    }
+
+    _pathDeferred = false;
     i_recalculateTravel = true;
 
     bool success = i_path->CalculatePath(x, y, z, forceDest);
@@ -335,6 +351,21 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
 
     target->GetNearPoint(owner, x, y, z, _range, 0.f, target->ToAbsoluteAngle(tAngle));
 
+    if (!i_path->PrepareCorridor(x, y, z))
+    {
+        _lastTargetPosition.reset();
+        return true;
+    }
+
+    // the map ran out of paths for this tick, keep the current spline and retry on the next one without the budget check
+    if (!_pathDeferred && !owner->GetMap()->ConsumePathBudget())
+    {
+        _pathDeferred = true;
+        _lastTargetPosition.reset();
+        return true;
+    }
+
+    _pathDeferred = false;
     i_recalculateTravel = true;
 
     bool success = i_path->CalculatePath(x, y, z, forceDest);
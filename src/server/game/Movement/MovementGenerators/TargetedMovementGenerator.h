@@ -57,6 +57,7 @@ private:
     std::optional<ChaseAngle> const _angle;
     bool _movingTowards = true;
     bool _mutualChase = true;
+    bool _pathDeferred = false;
 };
 
 template<class T>
@@ -94,6 +95,7 @@ private:
     std::optional<Position> _lastTargetPosition;
     float _range;
     ChaseAngle _angle;
+    bool _pathDeferred = false;
 };
 
 #endif
@@ -1,6 +1,6 @@
 //add here most rarely modified headers to speed up debug build compilation
 
-#include "WorldSocket.h"        // must be first to make ACE happy with ACE includes in it
+#include "WorldSocket.h"
 
 #include "Common.h"
 #include "Log.h"
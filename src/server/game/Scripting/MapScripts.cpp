@@ -32,6 +32,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
     ObjectGuid targetGUID = target ? target->GetGUID() : ObjectGuid::Empty;
     ObjectGuid ownerGUID  = (source && source->GetTypeId() == TYPEID_ITEM) ? ((Item*)source)->GetOwnerGUID() : ObjectGuid::Empty;
 
+    auto guard = GetRegionUpdateGuard();
+
     ///- Schedule script execution for all scripts in the script map
     ScriptMap const* s2 = &(s->second);
     bool immedScript = false;
@@ -50,7 +52,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sScriptMgr->IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !i_scriptLock)
+    ///- scripts may touch objects of any region, so during region updates they wait for the merge phase
+    if (/*start &&*/ immedScript && !i_scriptLock && !_regionUpdateInProgress)
     {
         i_scriptLock = true;
         ScriptsProcess();
@@ -73,12 +76,14 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID  = ownerGUID;
 
     sa.script = &script;
+
+    auto guard = GetRegionUpdateGuard();
     m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld->GetGameTime() + delay), sa));
 
     sScriptMgr->IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !i_scriptLock)
+    if (delay == 0 && !i_scriptLock && !_regionUpdateInProgress)
     {
         i_scriptLock = true;
         ScriptsProcess();
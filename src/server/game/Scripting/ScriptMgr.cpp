@@ -2055,6 +2055,10 @@ void ScriptMgr::Creature_SelectLevel(const CreatureTemplate* cinfo, Creature* cr
 {
     FOREACH_SCRIPT(AllCreatureScript)->Creature_SelectLevel(cinfo, creature);
 }
+bool ScriptMgr::HasUnitUpdateHooks() const
+{
+    return !ScriptRegistry<AllCreatureScript>::ScriptPointerList.empty() || !ScriptRegistry<UnitScript>::ScriptPointerList.empty();
+}
 void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 {
     FOREACH_SCRIPT(UnitScript)->OnHeal(healer, reciever, gain);
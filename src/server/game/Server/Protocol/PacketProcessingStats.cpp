@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PacketProcessingStats.h"
+#include <algorithm>
+
+PacketProcessingStats* PacketProcessingStats::instance()
+{
+    static PacketProcessingStats instance;
+    return &instance;
+}
+
+void PacketProcessingStats::Record(uint16 opcode, Microseconds duration)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    uint64 us = uint64(std::max<int64>(duration.count(), 0));
+
+    uint32 bucket = PACKET_PROCESSING_BUCKET_10US;
+    for (uint64 limit = 10; bucket < PACKET_PROCESSING_BUCKET_SLOW && us >= limit; limit *= 10)
+        ++bucket;
+
+    Counters& counters = _counters[opcode];
+    counters.Count.fetch_add(1, std::memory_order_relaxed);
+    counters.TotalUs.fetch_add(us, std::memory_order_relaxed);
+    counters.Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint64 max = counters.MaxUs.load(std::memory_order_relaxed);
+    while (us > max && !counters.MaxUs.compare_exchange_weak(max, us, std::memory_order_relaxed));
+}
+
+void PacketProcessingStats::Reset()
+{
+    for (Counters& counters : _counters)
+    {
+        counters.Count.store(0, std::memory_order_relaxed);
+        counters.TotalUs.store(0, std::memory_order_relaxed);
+        counters.MaxUs.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64>& bucket : counters.Buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+PacketProcessingStatsEntry PacketProcessingStats::GetStats(uint16 opcode) const
+{
+    PacketProcessingStatsEntry entry;
+    entry.Opcode = opcode;
+    if (opcode >= NUM_MSG_TYPES)
+        return entry;
+
+    Counters const& counters = _counters[opcode];
+    entry.Count = counters.Count.load(std::memory_order_relaxed);
+    entry.TotalUs = counters.TotalUs.load(std::memory_order_relaxed);
+    entry.MaxUs = counters.MaxUs.load(std::memory_order_relaxed);
+    for (uint32 i = 0; i < MAX_PACKET_PROCESSING_BUCKETS; ++i)
+        entry.Buckets[i] = counters.Buckets[i].load(std::memory_order_relaxed);
+
+    return entry;
+}
+
+std::vector<PacketProcessingStatsEntry> PacketProcessingStats::GetTopOpcodes(std::size_t count) const
+{
+    std::vector<PacketProcessingStatsEntry> entries;
+    for (uint16 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+        if (_counters[opcode].Count.load(std::memory_order_relaxed))
+            entries.push_back(GetStats(opcode));
+
+    std::sort(entries.begin(), entries.end(), [](PacketProcessingStatsEntry const& left, PacketProcessingStatsEntry const& right)
+    {
+        return left.TotalUs > right.TotalUs;
+    });
+
+    if (entries.size() > count)
+        entries.resize(count);
+
+    return entries;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef ACORE_PACKETPROCESSINGSTATS_H
+#define ACORE_PACKETPROCESSINGSTATS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+enum PacketProcessingBucket
+{
+    PACKET_PROCESSING_BUCKET_10US,      // < 10us
+    PACKET_PROCESSING_BUCKET_100US,     // < 100us
+    PACKET_PROCESSING_BUCKET_1MS,       // < 1ms
+    PACKET_PROCESSING_BUCKET_10MS,      // < 10ms
+    PACKET_PROCESSING_BUCKET_100MS,     // < 100ms
+    PACKET_PROCESSING_BUCKET_SLOW,      // >= 100ms
+
+    MAX_PACKET_PROCESSING_BUCKETS
+};
+
+struct PacketProcessingStatsEntry
+{
+    uint16 Opcode = 0;
+    uint64 Count = 0;
+    uint64 TotalUs = 0;
+    uint64 MaxUs = 0;
+    std::array<uint64, MAX_PACKET_PROCESSING_BUCKETS> Buckets = { };
+};
+
+/// Handler time histograms of the client opcodes processed by WorldSession::Update, shared by the world and map threads
+class PacketProcessingStats
+{
+private:
+    PacketProcessingStats() = default;
+    ~PacketProcessingStats() = default;
+
+public:
+    static PacketProcessingStats* instance();
+
+    void Record(uint16 opcode, Microseconds duration);
+    void Reset();
+
+    PacketProcessingStatsEntry GetStats(uint16 opcode) const;
+    /// Opcodes with the highest total handler time first
+    std::vector<PacketProcessingStatsEntry> GetTopOpcodes(std::size_t count) const;
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64> Count{ 0 };
+        std::atomic<uint64> TotalUs{ 0 };
+        std::atomic<uint64> MaxUs{ 0 };
+        std::array<std::atomic<uint64>, MAX_PACKET_PROCESSING_BUCKETS> Buckets{ };
+    };
+
+    std::array<Counters, NUM_MSG_TYPES> _counters;
+};
+
+#define sPacketProcessingStats PacketProcessingStats::instance()
+
+#endif
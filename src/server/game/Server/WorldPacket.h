@@ -10,6 +10,7 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 #include "Duration.h"
+#include <atomic>
 
 class WorldPacket : public ByteBuffer
 {
@@ -65,6 +66,10 @@ public:
     void SetOpcode(uint16 opcode) { m_opcode = opcode; }
 
     [[nodiscard]] TimePoint GetReceivedTime() const { return m_receivedTime; }
+    void SetReceivedTime(TimePoint receivedTime) { m_receivedTime = receivedTime; }
+
+    // link used by the session receive queue and packet pool, not copied with the packet
+    std::atomic<WorldPacket*> QueueLink;
 
 protected:
     uint16 m_opcode;
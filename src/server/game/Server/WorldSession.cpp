@@ -8,7 +8,7 @@
     \ingroup u2w
 */
 
-#include "WorldSocket.h"                                    // must be first to make ACE happy with ACE includes in it
+#include "WorldSocket.h"
 #include "AccountMgr.h"
 #include "BattlegroundMgr.h"
 #include "Common.h"
@@ -22,6 +22,7 @@
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
+#include "PacketProcessingStats.h"
 #include "PacketUtilities.h"
 #include "Pet.h"
 #include "Player.h"
@@ -90,7 +91,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
 }
 
 /// WorldSession constructor
-WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, bool skipQueue, uint32 TotalTime) :
+WorldSession::WorldSession(uint32 id, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, bool skipQueue, uint32 TotalTime) :
     m_muteTime(mute_time),
     m_timeOutTime(0),
     _lastAuctionListItemsMSTime(0),
@@ -98,7 +99,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     AntiDOS(this),
     m_GUIDLow(0),
     _player(nullptr),
-    m_Socket(sock),
+    m_Socket(std::move(sock)),
     _security(sec),
     _skipQueue(skipQueue),
     _accountId(id),
@@ -115,6 +116,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_TutorialsChanged(false),
     recruiterId(recruiter),
     isRecruiter(isARecruiter),
+    _recvPacketPoolSize(0),
     m_currentVendorEntry(0),
     timeWhoCommandAllowed(0),
     _calendarEventCreationCooldown(0),
@@ -132,10 +134,9 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     _timeSyncNextCounter = 0;
     _timeSyncTimer = 0;
 
-    if (sock)
+    if (m_Socket)
     {
-        m_Address = sock->GetRemoteAddress();
-        sock->AddReference();
+        m_Address = m_Socket->GetRemoteAddress();
         ResetTimeOutTime(false);
         LoginDatabase.PExecute("UPDATE account SET online = 1 WHERE id = %u;", GetAccountId());
     }
@@ -156,8 +157,7 @@ WorldSession::~WorldSession()
     if (m_Socket)
     {
         m_Socket->CloseSocket("WorldSession destructor");
-        m_Socket->RemoveReference();
-        m_Socket = nullptr;
+        m_Socket.reset();
     }
 
     if (_warden)
@@ -171,6 +171,10 @@ WorldSession::~WorldSession()
     while (_recvQueue.next(packet))
         delete packet;
 
+    ///- the socket is closed, nothing can take packets from the pool anymore
+    while (_recvPacketPool.next(packet))
+        delete packet;
+
     if (GetShouldSetOfflineInDB())
         LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 }
@@ -269,6 +273,32 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
     _recvQueue.add(new_packet);
 }
 
+/// Packets kept for reuse per session and the largest packet worth keeping
+#define RECV_PACKET_POOL_MAX_PACKETS 32
+#define RECV_PACKET_POOL_MAX_PACKET_SIZE 2048
+
+WorldPacket* WorldSession::AcquireRecvPacket()
+{
+    WorldPacket* packet = nullptr;
+    if (!_recvPacketPool.next(packet))
+        return nullptr;
+
+    --_recvPacketPoolSize;
+    return packet;
+}
+
+void WorldSession::ReleaseRecvPacket(WorldPacket* packet)
+{
+    if (packet->size() > RECV_PACKET_POOL_MAX_PACKET_SIZE || _recvPacketPoolSize >= RECV_PACKET_POOL_MAX_PACKETS)
+    {
+        delete packet;
+        return;
+    }
+
+    ++_recvPacketPoolSize;
+    _recvPacketPool.add(packet);
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char* reason)
 {
@@ -310,10 +340,11 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     uint32 processedPackets = 0;
     time_t currentTime = time(nullptr);
 
-    while (m_Socket && !m_Socket->IsClosed() && !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket && _recvQueue.next(packet, updater))
+    while (m_Socket && !m_Socket->IsClosed() && !_recvQueue.empty() && _recvQueue.peek() != firstDelayedPacket && _recvQueue.next(packet, updater))
     {
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
+        TimePoint processStart = std::chrono::steady_clock::now();
 
         try
         {
@@ -401,8 +432,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
+        sPacketProcessingStats->Record(opcode, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - processStart));
+
         if (deletePacket)
-            delete packet;
+            ReleaseRecvPacket(packet);
 
         deletePacket = true;
 
@@ -436,8 +469,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
         if (m_Socket && m_Socket->IsClosed())
         {
-            m_Socket->RemoveReference();
-            m_Socket = nullptr;
+            m_Socket.reset();
         }
 
         if (!m_Socket)
@@ -469,8 +501,7 @@ bool WorldSession::HandleSocketClosed()
 {
     if (m_Socket && m_Socket->IsClosed() && !IsKicked() && GetPlayer() && !PlayerLogout() && GetPlayer()->m_taxi.empty() && GetPlayer()->IsInWorld() && !World::IsStopped())
     {
-        m_Socket->RemoveReference();
-        m_Socket = nullptr;
+        m_Socket.reset();
         GetPlayer()->TradeCancel(false);
         return true;
     }
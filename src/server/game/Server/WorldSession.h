@@ -19,6 +19,7 @@
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "GossipDef.h"
+#include "MPSCQueue.h"
 #include "Packet.h"
 #include "SharedDefines.h"
 #include "World.h"
@@ -200,7 +201,7 @@ struct PacketCounter
 class WorldSession
 {
 public:
-    WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, bool skipQueue, uint32 TotalTime);
+    WorldSession(uint32 id, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, bool skipQueue, uint32 TotalTime);
     ~WorldSession();
 
     bool PlayerLoading() const { return m_playerLoading; }
@@ -269,6 +270,11 @@ public:
     void KickPlayer(std::string const& reason, bool setKicked = true);
 
     void QueuePacket(WorldPacket* new_packet);
+
+    /// Receive packet pool, acquire is only called by the network thread owning the socket
+    WorldPacket* AcquireRecvPacket();
+    void ReleaseRecvPacket(WorldPacket* packet);
+
     bool Update(uint32 diff, PacketFilter& updater);
 
     /// Handle the authentication waiting queue (to be completed)
@@ -1017,7 +1023,7 @@ private:
 
     ObjectGuid::LowType m_GUIDLow;
     Player* _player;
-    WorldSocket* m_Socket;
+    std::shared_ptr<WorldSocket> m_Socket;
     std::string m_Address;
     // std::string m_LAddress;                             // Last Attempted Remote Adress - we can not set attempted ip for a non-existing session!
 
@@ -1046,7 +1052,9 @@ private:
     AddonsList m_addonsList;
     uint32 recruiterId;
     bool isRecruiter;
-    LockedQueue<WorldPacket*> _recvQueue;
+    MPSCQueue<WorldPacket, &WorldPacket::QueueLink> _recvQueue;
+    MPSCQueue<WorldPacket, &WorldPacket::QueueLink> _recvPacketPool;
+    std::atomic<uint32> _recvPacketPoolSize;
     uint32 m_currentVendorEntry;
     ObjectGuid m_currentBankerGUID;
     time_t timeWhoCommandAllowed;
@@ -23,15 +23,7 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "WorldSocket.h"
-#include "WorldSocketMgr.h"
-#include <ace/Message_Block.h>
-#include <ace/os_include/arpa/os_inet.h>
-#include <ace/os_include/netinet/os_tcp.h>
-#include <ace/os_include/sys/os_socket.h>
-#include <ace/os_include/sys/os_types.h>
-#include <ace/OS_NS_string.h>
-#include <ace/OS_NS_unistd.h>
-#include <ace/Reactor.h>
+#include <memory>
 #include <thread>
 
 #ifdef ELUNA
@@ -143,34 +135,33 @@ struct AccountInfo
     }
 };
 
-WorldSocket::WorldSocket(void): WorldHandler(),
-    m_LastPingTime(SystemTimePoint::min()), m_OverSpeedPings(0), m_Session(0),
-    m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-    m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false)
+WorldSocket::WorldSocket(tcp::socket&& socket) : BaseSocket(std::move(socket)),
+    m_LastPingTime(SystemTimePoint::min()), m_OverSpeedPings(0), m_Address(GetRemoteIpAddress().to_string()),
+    m_Session(nullptr), m_SendBuffer(0), m_SendFlushPosted(false)
 {
     Acore::Crypto::GetRandomBytes(m_Seed);
 
-    reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
-
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
+    m_HeaderBuffer.Resize(sizeof(ClientPktHeader));
 }
 
-WorldSocket::~WorldSocket(void)
-{
-    delete m_RecvWPct;
-
-    if (m_OutBuffer)
-        m_OutBuffer->release();
+WorldSocket::~WorldSocket() = default;
 
-    closing_ = true;
+void WorldSocket::Start()
+{
+    // sockets are started by the acceptor thread, do the handshake on the network thread owning the socket
+    PostToSocketContext([self = shared_from_this()]()
+    {
+        // Send startup packet.
+        WorldPacket packet(SMSG_AUTH_CHALLENGE, 40);
+        packet << uint32(1);                                    // 1...31
+        packet.append(self->m_Seed);
+        packet.append(Acore::Crypto::GetRandomBytes<32>()); // new encryption seeds
 
-    peer().close();
-}
+        if (self->SendPacket(packet) == -1)
+            return;
 
-bool WorldSocket::IsClosed(void) const
-{
-    return closing_;
+        self->AsyncRead();
+    });
 }
 
 void WorldSocket::CloseSocket(std::string const& reason)
@@ -178,33 +169,19 @@ void WorldSocket::CloseSocket(std::string const& reason)
     if (!reason.empty())
         LOG_DEBUG("network", "Socket closed because of: %s", reason.c_str());
 
-    {
-        std::lock_guard<std::mutex> guard(m_OutBufferLock);
-
-        if (closing_)
-            return;
-
-        closing_ = true;
-        peer().close_writer();
-    }
-
-    {
-        std::lock_guard<std::mutex> guard(m_SessionLock);
-
-        m_Session = nullptr;
-    }
+    CloseSocket();
 }
 
-const std::string& WorldSocket::GetRemoteAddress(void) const
+void WorldSocket::OnClose()
 {
-    return m_Address;
+    std::lock_guard<std::mutex> guard(m_SessionLock);
+
+    m_Session = nullptr;
 }
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
 {
-    std::lock_guard<std::mutex> guard(m_OutBufferLock);
-
-    if (closing_)
+    if (!IsOpen())
         return -1;
 
     // Dump outgoing packet.
@@ -213,492 +190,155 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
 
     ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
 
-    if (m_Crypt.IsInitialized())
-        m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
-
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
     {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ABORT();
+        std::lock_guard<std::mutex> guard(m_SendLock);
 
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
-                ABORT();
-    }
-    else
-    {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        if (m_Crypt.IsInitialized())
+            m_Crypt.EncryptSend(header.header, header.getHeaderLength());
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+        std::size_t packetSize = header.getHeaderLength() + pct.size();
+        if (m_SendBuffer.GetRemainingSpace() < packetSize)
+            m_SendBuffer.Resize(std::max<std::size_t>({ READ_BLOCK_SIZE, m_SendBuffer.GetBufferSize() * 3 / 2, m_SendBuffer.GetBufferSize() + packetSize }));
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+        m_SendBuffer.Write(header.header, header.getHeaderLength());
 
         if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
-
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            LOG_ERROR("server", "WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
-        }
+            m_SendBuffer.Write(pct.contents(), pct.size());
     }
 
-    return 0;
-}
-
-long WorldSocket::AddReference(void)
-{
-    return static_cast<long> (add_reference());
-}
-
-long WorldSocket::RemoveReference(void)
-{
-    return static_cast<long> (remove_reference());
-}
-
-int WorldSocket::open(void* a)
-{
-    ACE_UNUSED_ARG (a);
-
-    // Prevent double call to this func.
-    if (m_OutBuffer)
-        return -1;
-
-    // This will also prevent the socket from being Updated
-    // while we are initializing it.
-    m_OutActive = true;
-
-    // Hook for the manager.
-    if (sWorldSocketMgr->OnSocketOpen(this) == -1)
-        return -1;
-
-    // Allocate the buffer.
-    ACE_NEW_RETURN (m_OutBuffer, ACE_Message_Block (m_OutBufferSize), -1);
-
-    // Store peer address.
-    ACE_INET_Addr remote_addr;
-
-    if (peer().get_remote_addr(remote_addr) == -1)
-    {
-        LOG_ERROR("server", "WorldSocket::open: peer().get_remote_addr errno = %s", ACE_OS::strerror (errno));
-        return -1;
-    }
-
-    m_Address = remote_addr.get_host_addr();
-
-    // Send startup packet.
-    WorldPacket packet (SMSG_AUTH_CHALLENGE, 24);
-    packet << uint32(1);                                    // 1...31
-    packet.append(m_Seed);
-    packet.append(Acore::Crypto::GetRandomBytes<32>()); // new encryption seeds
-
-    if (SendPacket(packet) == -1)
-        return -1;
-
-    // Register with ACE Reactor
-    if (reactor()->register_handler(this, ACE_Event_Handler::READ_MASK | ACE_Event_Handler::WRITE_MASK) == -1)
-    {
-        LOG_ERROR("server", "WorldSocket::open: unable to register client handler errno = %s", ACE_OS::strerror (errno));
-        return -1;
-    }
-
-    // reactor takes care of the socket from now on
-    remove_reference();
+    // only the first packet after a flush has to wake up the network thread
+    if (!m_SendFlushPosted.exchange(true))
+        PostToSocketContext(std::bind(&WorldSocket::FlushSendBuffer, shared_from_this()));
 
     return 0;
 }
 
-int WorldSocket::close(u_long)
-{
-    shutdown();
-
-    closing_ = true;
-
-    remove_reference();
-
-    return 0;
-}
-
-int WorldSocket::handle_input(ACE_HANDLE)
-{
-    if (closing_)
-        return -1;
-
-    switch (handle_input_missing_data())
-    {
-        case -1 :
-            {
-                if ((errno == EWOULDBLOCK) ||
-                        (errno == EAGAIN))
-                {
-                    return Update();                           // interesting line, isn't it ?
-                }
-
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                LOG_DEBUG("server", "WorldSocket::handle_input: Peer error closing connection errno = %s", ACE_OS::strerror (errno));
-#endif
-
-                errno = ECONNRESET;
-                return -1;
-            }
-        case 0:
-            {
-#if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
-                LOG_DEBUG("server", "WorldSocket::handle_input: Peer has closed connection");
-#endif
-
-                errno = ECONNRESET;
-                return -1;
-            }
-        case 1:
-            return 1;
-        default:
-            return Update();                               // another interesting line ;)
-    }
-
-    return -1;
-}
-
-int WorldSocket::handle_output(ACE_HANDLE)
+void WorldSocket::FlushSendBuffer()
 {
-    if (closing_)
-        return -1;
-
-    std::lock_guard<std::mutex> guard(m_OutBufferLock);
+    // reset before taking the buffer, packets added after this point post a new flush
+    m_SendFlushPosted = false;
 
-    size_t send_len = m_OutBuffer->length();
+    std::unique_lock<std::mutex> guard(m_SendLock);
 
-    if (send_len == 0)
-        return handle_output_queue();
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
-        return -1;
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output();
-
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
+    if (!m_SendBuffer.GetActiveSize())
+        return;
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    MessageBuffer buffer(std::move(m_SendBuffer));
+    guard.unlock();
 
-        return schedule_wakeup_output();
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset();
-
-        return handle_output_queue();
-    }
-
-    ACE_NOTREACHED (return 0);
+    QueuePacket(std::move(buffer));
 }
 
-int WorldSocket::handle_output_queue()
+void WorldSocket::ReadHandler()
 {
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output();
-
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        LOG_ERROR("server", "WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
+    if (!IsOpen())
+        return;
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
+    MessageBuffer& packet = GetReadBuffer();
+    while (packet.GetActiveSize() > 0)
     {
-        mblk->release();
-
-        return -1;
-    }
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output();
-        }
-
-        mblk->release();
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
-
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
-        {
-            LOG_ERROR("server", "WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
-        }
-
-        return schedule_wakeup_output();
-    }
-    else //now n == send_len
-    {
-        mblk->release();
-
-        return msg_queue()->is_empty() ? cancel_wakeup_output() : ACE_Event_Handler::WRITE_MASK;
-    }
-
-    return -1;
-}
-
-int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
-{
-    // Critical section
-    {
-        std::lock_guard<std::mutex> guard(m_OutBufferLock);
-
-        closing_ = true;
-
-        if (h == ACE_INVALID_HANDLE)
-            peer().close_writer();
-    }
-
-    // Critical section
-    {
-        std::lock_guard<decltype(m_SessionLock)> guard(m_SessionLock);
-
-        m_Session = nullptr;
-    }
-
-    reactor()->remove_handler(this, ACE_Event_Handler::DONT_CALL | ACE_Event_Handler::ALL_EVENTS_MASK);
-    return 0;
-}
-
-int WorldSocket::Update(void)
-{
-    if (closing_)
-        return -1;
-
-    if (m_OutActive)
-        return 0;
-
-    {
-        std::lock_guard<std::mutex> guard(m_OutBufferLock);
-
-        if (m_OutBuffer->length() == 0 && msg_queue()->is_empty())
-            return 0;
-    }
-
-    int ret;
-    do
-        ret = handle_output (get_handle());
-    while (ret > 0);
-
-    return ret;
-}
-
-int WorldSocket::handle_input_header(void)
-{
-    ASSERT(m_RecvWPct == nullptr);
-    ASSERT(m_Header.length() == sizeof(ClientPktHeader));
-
-    if (m_Crypt.IsInitialized())
-        m_Crypt.DecryptRecv((uint8*) m_Header.rd_ptr(), sizeof(ClientPktHeader));
-
-    ClientPktHeader& header = *((ClientPktHeader*) m_Header.rd_ptr());
-
-    EndianConvertReverse(header.size);
-    EndianConvert(header.cmd);
-
-    if ((header.size < 4) || (header.size > 10240) || (header.cmd > 10240))
-    {
-        LOG_ERROR("server", "WorldSocket::handle_input_header(): client (%s) sent malformed packet (size: %hd, cmd: %d)",
-            GetRemoteAddress().c_str(), header.size, header.cmd);
-
-        errno = EINVAL;
-        return -1;
-    }
-
-    header.size -= 4;
-
-    ACE_NEW_RETURN (m_RecvWPct, WorldPacket ((uint16) header.cmd, header.size), -1);
-
-    if (header.size > 0)
-    {
-        m_RecvWPct->resize (header.size);
-        m_RecvPct.base ((char*) m_RecvWPct->contents(), m_RecvWPct->size());
-    }
-    else
-    {
-        ASSERT(m_RecvPct.space() == 0);
-    }
-
-    return 0;
-}
-
-int WorldSocket::handle_input_payload(void)
-{
-    // set errno properly here on error !!!
-    // now have a header and payload
-
-    ASSERT(m_RecvPct.space() == 0);
-    ASSERT(m_Header.space() == 0);
-    ASSERT(m_RecvWPct != nullptr);
-
-    const int ret = ProcessIncoming (m_RecvWPct);
-
-    m_RecvPct.base (nullptr, 0);
-    m_RecvPct.reset();
-    m_RecvWPct = nullptr;
-
-    m_Header.reset();
-
-    if (ret == -1)
-        errno = EINVAL;
-
-    return ret;
-}
-
-int WorldSocket::handle_input_missing_data(void)
-{
-    char buf [4096];
-
-    ACE_Data_Block db (sizeof (buf),
-                       ACE_Message_Block::MB_DATA,
-                       buf,
-                       0,
-                       0,
-                       ACE_Message_Block::DONT_DELETE,
-                       0);
-
-    ACE_Message_Block message_block(&db,
-                                    ACE_Message_Block::DONT_DELETE,
-                                    0);
-
-    const size_t recv_size = message_block.space();
-
-    const ssize_t n = peer().recv (message_block.wr_ptr(),
-                                   recv_size);
-
-    if (n <= 0)
-        return int(n);
-
-    message_block.wr_ptr (n);
-
-    while (message_block.length() > 0)
-    {
-        if (m_Header.space() > 0)
+        if (m_HeaderBuffer.GetRemainingSpace() > 0)
         {
-            //need to receive the header
-            const size_t to_header = (message_block.length() > m_Header.space() ? m_Header.space() : message_block.length());
-            m_Header.copy (message_block.rd_ptr(), to_header);
-            message_block.rd_ptr (to_header);
+            // need to receive the header
+            std::size_t readHeaderSize = std::min(packet.GetActiveSize(), m_HeaderBuffer.GetRemainingSpace());
+            m_HeaderBuffer.Write(packet.GetReadPointer(), readHeaderSize);
+            packet.ReadCompleted(readHeaderSize);
 
-            if (m_Header.space() > 0)
+            if (m_HeaderBuffer.GetRemainingSpace() > 0)
             {
                 // Couldn't receive the whole header this time.
-                ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
-                return -1;
+                ASSERT(packet.GetActiveSize() == 0);
+                break;
             }
 
             // We just received nice new header
-            if (handle_input_header() == -1)
+            if (!ReadHeaderHandler())
             {
-                ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
-                return -1;
+                CloseSocket();
+                return;
             }
         }
 
-        // Its possible on some error situations that this happens
-        // for example on closing when epoll receives more chunked data and stuff
-        // hope this is not hack, as proper m_RecvWPct is asserted around
-        if (!m_RecvWPct)
-        {
-            LOG_ERROR("server", "Forcing close on input m_RecvWPct = nullptr");
-            errno = EINVAL;
-            return -1;
-        }
-
         // We have full read header, now check the data payload
-        if (m_RecvPct.space() > 0)
+        if (m_PacketBuffer.GetRemainingSpace() > 0)
         {
-            //need more data in the payload
-            const size_t to_data = (message_block.length() > m_RecvPct.space() ? m_RecvPct.space() : message_block.length());
-            m_RecvPct.copy (message_block.rd_ptr(), to_data);
-            message_block.rd_ptr (to_data);
+            // need more data in the payload
+            std::size_t readDataSize = std::min(packet.GetActiveSize(), m_PacketBuffer.GetRemainingSpace());
+            m_PacketBuffer.Write(packet.GetReadPointer(), readDataSize);
+            packet.ReadCompleted(readDataSize);
 
-            if (m_RecvPct.space() > 0)
+            if (m_PacketBuffer.GetRemainingSpace() > 0)
             {
                 // Couldn't receive the whole data this time.
-                ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
-                return -1;
+                ASSERT(packet.GetActiveSize() == 0);
+                break;
             }
         }
 
-        //just received fresh new payload
-        if (handle_input_payload() == -1)
+        // just received fresh new payload
+        int result = ReadDataHandler();
+        m_HeaderBuffer.Reset();
+
+        if (result == -1)
         {
-            ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
-            return -1;
+            // write out the responses queued so far (e.g. the auth response) before closing
+            FlushSendBuffer();
+            DelayedCloseSocket();
+            return;
         }
     }
 
-    return size_t(n) == recv_size ? 1 : 2;
+    AsyncRead();
 }
 
-int WorldSocket::cancel_wakeup_output()
+bool WorldSocket::ReadHeaderHandler()
 {
-    if (!m_OutActive)
-        return 0;
+    ASSERT(m_HeaderBuffer.GetActiveSize() == sizeof(ClientPktHeader));
+
+    if (m_Crypt.IsInitialized())
+        m_Crypt.DecryptRecv(m_HeaderBuffer.GetReadPointer(), sizeof(ClientPktHeader));
 
-    m_OutActive = false;
+    ClientPktHeader* header = reinterpret_cast<ClientPktHeader*>(m_HeaderBuffer.GetReadPointer());
 
-    if (reactor()->cancel_wakeup
-            (this, ACE_Event_Handler::WRITE_MASK) == -1)
+    EndianConvertReverse(header->size);
+    EndianConvert(header->cmd);
+
+    if ((header->size < 4) || (header->size > 10240) || (header->cmd > 10240))
     {
-        // would be good to store errno from reactor with errno guard
-        LOG_ERROR("server", "WorldSocket::cancel_wakeup_output");
-        return -1;
+        LOG_ERROR("server", "WorldSocket::ReadHeaderHandler(): client (%s) sent malformed packet (size: %hu, cmd: %u)",
+            GetRemoteAddress().c_str(), header->size, header->cmd);
+        return false;
     }
 
-    return 0;
+    header->size -= 4;
+
+    m_PacketBuffer.Reset();
+    m_PacketBuffer.Resize(header->size);
+    return true;
 }
 
-int WorldSocket::schedule_wakeup_output()
+int WorldSocket::ReadDataHandler()
 {
-    if (m_OutActive)
-        return 0;
+    ClientPktHeader* header = reinterpret_cast<ClientPktHeader*>(m_HeaderBuffer.GetReadPointer());
 
-    m_OutActive = true;
+    WorldPacket* packet = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(m_SessionLock);
+        if (m_Session)
+            packet = m_Session->AcquireRecvPacket();
+    }
 
-    if (reactor()->schedule_wakeup
-            (this, ACE_Event_Handler::WRITE_MASK) == -1)
+    // reuse a packet already processed by the session, its buffer is usually large enough already
+    if (packet)
     {
-        LOG_ERROR("server", "WorldSocket::schedule_wakeup_output");
-        return -1;
+        packet->Initialize(uint16(header->cmd), 0);
+        if (std::size_t size = m_PacketBuffer.GetActiveSize())
+            packet->append(m_PacketBuffer.GetReadPointer(), size);
+
+        return ProcessIncoming(packet);
     }
 
-    return 0;
+    return ProcessIncoming(new WorldPacket(uint16(header->cmd), std::move(m_PacketBuffer)));
 }
 
 int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
@@ -710,7 +350,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
     OpcodeClient opcode = static_cast<OpcodeClient>(aptr->GetOpcode());
 
-    if (closing_)
+    if (!IsOpen())
         return -1;
 
     // Dump received packet.
@@ -741,7 +381,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
                     m_Session->ResetTimeOutTime(true);
                 return 0;
             case CMSG_TIME_SYNC_RESP:
-                new_pct = new WorldPacket(std::move(*new_pct), std::chrono::steady_clock::now());
+                new_pct->SetReceivedTime(std::chrono::steady_clock::now());
                 break;
             default:
                 break;
@@ -861,7 +501,10 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     // This also allows to check for possible "hack" attempts on account
 
     // even if auth credentials are bad, try using the session key we have - client cannot read auth response error without it
-    m_Crypt.Init(account.SessionKey);
+    {
+        std::lock_guard<std::mutex> guard(m_SendLock);
+        m_Crypt.Init(account.SessionKey);
+    }
 
     // First reject the connection if packet contains invalid data or realm state doesn't allow logging in
     if (sWorld->IsClosed())
@@ -989,8 +632,7 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
         skipQueue = true;
 
     // NOTE ATM the socket is single-threaded, have this in mind ...
-    ACE_NEW_RETURN(m_Session,
-        WorldSession(account.Id, this, AccountTypes(account.Security), account.Expansion, account.MuteTime, account.Locale, account.Recruiter, account.IsRectuiter, skipQueue, account.TotalTime), -1);
+    m_Session = new WorldSession(account.Id, shared_from_this(), AccountTypes(account.Security), account.Expansion, account.MuteTime, account.Locale, account.Recruiter, account.IsRectuiter, skipQueue, account.TotalTime);
 
     m_Session->LoadGlobalAccountData();
     m_Session->LoadTutorialsData();
@@ -7,7 +7,6 @@
 /** \addtogroup u2w User to World Communication
  * @{
  * \file WorldSocket.h
- * \author Derex <derex101@gmail.com>
  */
 
 #ifndef _WORLDSOCKET_H
@@ -16,18 +15,11 @@
 #include "AuthCrypt.h"
 #include "Common.h"
 #include "Duration.h"
-#include <ace/Message_Block.h>
-#include <ace/SOCK_Stream.h>
-#include <ace/Svc_Handler.h>
-#include <ace/Synch_Traits.h>
-#include <ace/Unbounded_Queue.h>
+#include "MessageBuffer.h"
+#include "Socket.h"
+#include <atomic>
 #include <mutex>
 
-#if !defined (ACE_LACKS_PRAGMA_ONCE)
-#pragma once
-#endif /* ACE_LACKS_PRAGMA_ONCE */
-
-class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
 
@@ -36,117 +28,72 @@ namespace WorldPackets
     class ServerPacket;
 }
 
-/// Handler that can communicate over stream sockets.
-typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
-
 /**
  * WorldSocket.
  *
  * This class is responsible for the communication with
  * remote clients.
  * Most methods return -1 on failure.
- * The class uses reference counting.
- *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
- * does really a lot of small-size writes to it, and it doesn't
- * scale well to allocate memory for every. When something is
- * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() method).
- * This concept is similar to TCP_CORK, but TCP_CORK
- * uses 200ms celling. As result overhead generated by
- * sending packets from "producer" threads is minimal,
- * and doing a lot of writes with small size is tolerated.
- *
- * The calls to Update() method are managed by WorldSocketMgr
- * and ReactorRunnable.
- *
- * For input, the class uses one 4096 bytes buffer on stack
- * to which it does recv() calls. And then received data is
- * distributed where its needed. 4096 matches pretty well the
- * traffic generated by client for now.
- *
- * The input/output do speculative reads/writes (AKA it tryes
- * to read all data available in the kernel buffer or tryes to
- * write everything available in userspace buffer),
- * which is ok for using with Level and Edge Triggered IO
- * notification.
+ * The lifetime of the socket is managed by shared pointers,
+ * owned by the network thread and the WorldSession.
  *
+ * All reads and writes happen on the network thread owning the socket.
+ * SendPacket() can be called from any thread: it encrypts the header
+ * and appends the packet to a pending send buffer, then posts a single
+ * flush to the network thread. Every packet sent before the flush runs
+ * is written with the same send call, so there is no fixed delay
+ * between queuing a packet and writing it to the kernel.
  */
-class WorldSocket : public WorldHandler
+class WorldSocket : public Socket<WorldSocket>
 {
+    typedef Socket<WorldSocket> BaseSocket;
+
 public:
-    WorldSocket (void);
-    virtual ~WorldSocket (void);
+    WorldSocket(tcp::socket&& socket);
+    ~WorldSocket() override;
 
-    friend class WorldSocketMgr;
+    WorldSocket(WorldSocket const& right) = delete;
+    WorldSocket& operator=(WorldSocket const& right) = delete;
 
-    /// Check if socket is closed.
-    bool IsClosed (void) const;
+    void Start() override;
+
+    using BaseSocket::CloseSocket;
 
     /// Close the socket.
     void CloseSocket(std::string const& reason);
 
+    /// Check if socket is closed.
+    bool IsClosed() const { return !IsOpen(); }
+
     /// Get address of connected peer.
-    const std::string& GetRemoteAddress (void) const;
+    std::string const& GetRemoteAddress() const { return m_Address; }
 
     /// Send A packet on the socket, this function is reentrant.
     /// @param pct packet to send
     /// @return -1 of failure
-    int SendPacket(const WorldPacket& pct);
+    int SendPacket(WorldPacket const& pct);
 
-    /// Add reference to this object.
-    long AddReference (void);
-
-    /// Remove reference to this object.
-    long RemoveReference (void);
-
-    /// things called by ACE framework.
-
-    /// Called on open, the void* is the acceptor.
-    virtual int open (void*);
-
-    /// Called on failures inside of the acceptor, don't call from your code.
-    virtual int close (u_long);
-
-    /// Called when we can read from the socket.
-    virtual int handle_input (ACE_HANDLE = ACE_INVALID_HANDLE);
-
-    /// Called when the socket can write.
-    virtual int handle_output (ACE_HANDLE = ACE_INVALID_HANDLE);
-
-    /// Called when connection is closed or error happens.
-    virtual int handle_close (ACE_HANDLE = ACE_INVALID_HANDLE,
-                              ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK);
-
-    /// Called by WorldSocketMgr/ReactorRunnable.
-    int Update (void);
+protected:
+    void OnClose() override;
+    void ReadHandler() override;
 
 private:
     /// Helper functions for processing incoming data.
-    int handle_input_header (void);
-    int handle_input_payload (void);
-    int handle_input_missing_data (void);
-
-    /// Help functions to mark/unmark the socket for output.
-    /// @param g the guard is for m_OutBufferLock, the function will release it
-    int cancel_wakeup_output();
-    int schedule_wakeup_output();
+    bool ReadHeaderHandler();
+    int ReadDataHandler();
 
-    /// Drain the queue if its not empty.
-    int handle_output_queue();
+    /// Moves the pending send buffer to the write queue, runs on the network thread.
+    void FlushSendBuffer();
 
     /// process one incoming packet.
     /// @param new_pct received packet, note that you need to delete it.
-    int ProcessIncoming (WorldPacket* new_pct);
+    int ProcessIncoming(WorldPacket* new_pct);
 
     /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
-    int HandleAuthSession (WorldPacket& recvPacket);
+    int HandleAuthSession(WorldPacket& recvPacket);
 
     /// Called by ProcessIncoming() on CMSG_PING.
-    int HandlePing (WorldPacket& recvPacket);
+    int HandlePing(WorldPacket& recvPacket);
 
 private:
     /// Time in which the last ping was received
@@ -167,28 +114,20 @@ private:
     /// Session to which received packets are routed
     WorldSession* m_Session;
 
-    /// here are stored the fragments of the received data
-    WorldPacket* m_RecvWPct;
-
-    /// This block actually refers to m_RecvWPct contents,
-    /// which allows easy and safe writing to it.
-    /// It wont free memory when its deleted. m_RecvWPct takes care of freeing.
-    ACE_Message_Block m_RecvPct;
-
     /// Fragment of the received header.
-    ACE_Message_Block m_Header;
+    MessageBuffer m_HeaderBuffer;
 
-    /// Mutex for protecting output related data.
-    std::mutex m_OutBufferLock;
+    /// Payload of the packet being received.
+    MessageBuffer m_PacketBuffer;
 
-    /// Buffer used for writing output.
-    ACE_Message_Block* m_OutBuffer;
+    /// Mutex for protecting the send buffer and the header encryption, which must happen in send order.
+    std::mutex m_SendLock;
 
-    /// Size of the m_OutBuffer.
-    size_t m_OutBufferSize;
+    /// Packets waiting for the next flush.
+    MessageBuffer m_SendBuffer;
 
-    /// True if the socket is registered with the reactor for output
-    bool m_OutActive;
+    /// True if a flush is already posted to the network thread
+    std::atomic<bool> m_SendFlushPosted;
 
     std::array<uint8, 4> m_Seed;
 };
@@ -7,52 +7,44 @@
 /** \addtogroup u2w User to World Communication
  *  @{
  *  \file WorldSocketMgr.h
- *  \author Derex <derex101@gmail.com>
  */
 
 #ifndef __WORLDSOCKETMGR_H
 #define __WORLDSOCKETMGR_H
 
-#include "Common.h"
+#include "SocketMgr.h"
 
 class WorldSocket;
-class ReactorRunnable;
-class ACE_Event_Handler;
 
 /// Manages all sockets connected to peers and network threads
-class WorldSocketMgr
+class WorldSocketMgr : public SocketMgr<WorldSocket>
 {
-public:
-    friend class WorldSocket;
+    typedef SocketMgr<WorldSocket> BaseSocketMgr;
 
+public:
     static WorldSocketMgr* instance();
 
     /// Start network, listen at address:port .
-    int StartNetwork(uint16 port, const char* address);
+    bool StartNetwork(Acore::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount) override;
 
     /// Stops all network threads, It will wait for all running threads .
-    void StopNetwork();
-
-    /// Wait untill all network threads have "joined" .
-    void Wait();
-
-private:
-    int OnSocketOpen(WorldSocket* sock);
+    void StopNetwork() override;
 
-    int StartReactiveIO(uint16 port, const char* address);
+    void OnSocketOpen(tcp::socket&& sock, uint32 threadIndex) override;
 
-private:
+protected:
     WorldSocketMgr();
-    virtual ~WorldSocketMgr();
 
-    ReactorRunnable* m_NetThreads;
-    size_t m_NetThreadsCount;
+    NetworkThread<WorldSocket>* CreateThreads() const override;
 
-    int m_SockOutKBuff;
-    int m_SockOutUBuff;
-    bool m_UseNoDelay;
+    static void OnSocketAccept(tcp::socket&& sock, uint32 threadIndex)
+    {
+        instance()->OnSocketOpen(std::forward<tcp::socket>(sock), threadIndex);
+    }
 
-    class WorldSocketAcceptor* m_Acceptor;
+private:
+    int32 m_SockOutKBuff;
+    bool m_UseNoDelay;
 };
 
 #define sWorldSocketMgr WorldSocketMgr::instance()
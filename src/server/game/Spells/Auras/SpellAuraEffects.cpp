@@ -719,7 +719,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            UpdateTargetTotals();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -730,6 +733,12 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
             HandleEffect(*apptItr, handleMask, true);
 }
 
+void AuraEffect::UpdateTargetTotals()
+{
+    for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+        aurApp->GetTarget()->UpdateAuraEffectTotals(GetAuraType());
+}
+
 void AuraEffect::HandleEffect(AuraApplication* aurApp, uint8 mode, bool apply)
 {
     // check if call is correct, we really don't want using bitmasks here (with 1 exception)
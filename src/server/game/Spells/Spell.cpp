@@ -1283,6 +1283,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Acore::Containers::RandomResize(targets, maxTargets);
         }
 
+        PrefetchAreaTargetsLineOfSight(targets);
+
         for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unitTarget = (*itr)->ToUnit())
@@ -1936,6 +1938,44 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     SearchTargets<Acore::WorldObjectListSearcher<Acore::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range);
 }
 
+void Spell::PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets) const
+{
+    if (targets.size() < SPELL_LOS_BATCH_MIN_TARGETS || !sWorld->getBoolConfig(CONFIG_VMAP_LOS_CACHE))
+        return;
+
+    // same early outs as CheckEffectTarget
+    if (m_spellInfo->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT))
+        return;
+
+    if (IsTriggered() && m_triggeredByAuraSpell && (m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_triggeredByAuraSpell->Id, nullptr, SPELL_DISABLE_LOS)))
+        return;
+
+    WorldObject* caster = nullptr;
+    if (m_originalCasterGUID.IsGameObject())
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+
+    // a batch shares one phase mask, targets in other phases are checked one by one later
+    uint32 phaseMask = m_caster->GetPhaseMask();
+    std::vector<LineOfSightQuery> queries;
+    queries.reserve(targets.size());
+    for (WorldObject* object : targets)
+    {
+        Unit* target = object->ToUnit();
+        if (!target || target == m_caster || target->GetPhaseMask() != phaseMask)
+            continue;
+
+        if (m_targets.HasDst())
+            target->GetLineOfSightPoints(m_targets.GetDstPos()->GetPositionX(), m_targets.GetDstPos()->GetPositionY(), m_targets.GetDstPos()->GetPositionZ(), queries.emplace_back());
+        else if (target->IsInMap(caster))
+            target->GetLineOfSightPoints(caster, queries.emplace_back());
+    }
+
+    if (queries.size() >= SPELL_LOS_BATCH_MIN_TARGETS)
+        m_caster->GetMap()->isInLineOfSight(queries, phaseMask, LINEOFSIGHT_ALL_CHECKS);
+}
+
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories  /*selectCategory*/, ConditionList* condList, bool isChainHeal)
 {
     // max dist for jump target selection
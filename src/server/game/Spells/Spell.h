@@ -23,6 +23,8 @@ class SpellScript;
 class ByteBuffer;
 
 #define SPELL_CHANNEL_UPDATE_INTERVAL (1 * IN_MILLISECONDS)
+// area spells with fewer targets check their line of sight one by one
+#define SPELL_LOS_BATCH_MIN_TARGETS 4
 
 enum SpellCastFlags
 {
@@ -411,6 +413,8 @@ public:
 
     WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList = nullptr);
     void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, Unit* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList);
+    // checks the line of sight of all area targets in one batch, CheckEffectTarget then finds the results in the map's line of sight cache
+    void PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets) const;
     void SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionList* condList, bool isChainHeal);
 
     SpellCastResult prepare(SpellCastTargets const* targets, AuraEffect const* triggeredByAura = nullptr);
@@ -725,6 +725,19 @@ SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
     return nullptr;
 }
 
+uint32 SpellMgr::GetSpellProcEventFlags(SpellInfo const* spellInfo) const
+{
+    // auras with a spell_proc entry are handled by the new proc system
+    if (GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    if (SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id))
+        if (spellProcEvent->procFlags)
+            return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const
 {
     // No extra req need
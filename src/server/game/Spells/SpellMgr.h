@@ -648,6 +648,8 @@ public:
 
     // Spell proc event table
     [[nodiscard]] SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
+    // proc flags an aura of this spell reacts to in Unit::ProcDamageAndSpellFor, 0 if it never procs there
+    [[nodiscard]] uint32 GetSpellProcEventFlags(SpellInfo const* spellInfo) const;
     bool IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const;
 
     // Spell proc table
@@ -159,6 +159,11 @@ enum WorldBoolConfigs
     CONFIG_DUNGEON_ACCESS_REQUIREMENTS_LFG_DBC_LEVEL_OVERRIDE,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     CONFIG_SET_BOP_ITEM_TRADEABLE,
+    CONFIG_MAP_REGION_UPDATE,
+    CONFIG_UPDATE_PROFILER,
+    CONFIG_WORLD_DATA_CACHE,
+    CONFIG_MAP_FILES_MEMORY_MAPPED,
+    CONFIG_VMAP_LOS_CACHE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -375,6 +380,10 @@ enum WorldIntConfigs
     CONFIG_NPC_EVADE_IF_NOT_REACHABLE,
     CONFIG_NPC_REGEN_TIME_IF_NOT_REACHABLE_IN_RAID,
     CONFIG_FFA_PVP_TIMER,
+    CONFIG_MAP_REGION_UPDATE_MIN_PLAYERS,
+    CONFIG_LOAD_THREADS,
+    CONFIG_MMAP_PATH_BUDGET,
+    CONFIG_MMAP_PATH_THREADS,
     INT_CONFIG_VALUE_COUNT
 };
 
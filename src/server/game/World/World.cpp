@@ -51,6 +51,7 @@
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
+#include "PathSearchPool.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PoolMgr.h"
@@ -62,10 +63,12 @@
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "TaskGraph.h"
 #include "TemporarySummon.h"
 #include "TicketMgr.h"
 #include "Transport.h"
 #include "TransportMgr.h"
+#include "UpdateProfiler.h"
 #include "Util.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -75,6 +78,7 @@
 #include "WeatherMgr.h"
 #include "WhoListCache.h"
 #include "World.h"
+#include "WorldDataCache.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include <VMapManager2.h>
@@ -153,6 +157,7 @@ World::~World()
     while (cliCmdQueue.next(command))
         delete command;
 
+    sPathSearchPool->Stop();
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
@@ -637,9 +642,9 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_DURABILITY_LOSS_IN_PVP] = sConfigMgr->GetOption<bool>("DurabilityLoss.InPvP", false);
 
     m_int_configs[CONFIG_COMPRESSION] = sConfigMgr->GetOption<int32>("Compression", 1);
-    if (m_int_configs[CONFIG_COMPRESSION] < 1 || m_int_configs[CONFIG_COMPRESSION] > 9)
+    if (m_int_configs[CONFIG_COMPRESSION] > 9)
     {
-        LOG_ERROR("server", "Compression level (%u) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
+        LOG_ERROR("server", "Compression level (%u) must be in range 0..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
     m_bool_configs[CONFIG_ADDON_CHANNEL]                   = sConfigMgr->GetOption<bool>("AddonChannel", true);
@@ -1275,6 +1280,11 @@ void World::LoadConfigSettings(bool reload)
         LOG_INFO("server", "Using DataDir %s", m_dataPath.c_str());
     }
 
+    m_bool_configs[CONFIG_WORLD_DATA_CACHE] = sConfigMgr->GetOption<bool>("WorldDataCache.Enabled", false);
+    sWorldDataCache->SetEnabled(m_bool_configs[CONFIG_WORLD_DATA_CACHE]);
+    std::string worldDataCacheDirectory = sConfigMgr->GetOption<std::string>("WorldDataCache.Directory", "");
+    sWorldDataCache->SetDirectory(worldDataCacheDirectory.empty() ? m_dataPath : worldDataCacheDirectory);
+
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetOption<bool>("vmap.enableIndoorCheck", 0);
     bool enableIndoor = sConfigMgr->GetOption<bool>("vmap.enableIndoorCheck", true);
     bool enableLOS = sConfigMgr->GetOption<bool>("vmap.enableLOS", true);
@@ -1288,6 +1298,9 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     LOG_INFO("server", "WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i PetLOS:%i", enableLOS, enableHeight, enableIndoor, enablePetLOS);
 
+    m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED] = sConfigMgr->GetOption<bool>("MapFiles.MemoryMapped", true);
+    m_bool_configs[CONFIG_VMAP_LOS_CACHE] = sConfigMgr->GetOption<bool>("vmap.LOSCache", true);
+
     m_bool_configs[CONFIG_PET_LOS]          = sConfigMgr->GetOption<bool>("vmap.petLOS", true);
     m_bool_configs[CONFIG_START_ALL_SPELLS]   = sConfigMgr->GetOption<bool>("PlayerStart.CustomSpells", false);
     m_int_configs[CONFIG_HONOR_AFTER_DUEL]    = sConfigMgr->GetOption<int32>("HonorPointsAfterDuel", 0);
@@ -1308,7 +1321,12 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD]          = sConfigMgr->GetOption<bool>("ShowBanInWorld", false);
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE]         = sConfigMgr->GetOption<int32>("RecordUpdateTimeDiffInterval", 300000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE]              = sConfigMgr->GetOption<int32>("MinRecordUpdateTimeDiff", 100);
+    m_bool_configs[CONFIG_UPDATE_PROFILER]            = sConfigMgr->GetOption<bool>("UpdateProfiler.Enabled", false);
+    sUpdateProfiler->SetEnabled(m_bool_configs[CONFIG_UPDATE_PROFILER]);
     m_int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_REGION_UPDATE]          = sConfigMgr->GetOption<bool>("MapUpdate.Regions.Enabled", false);
+    m_int_configs[CONFIG_MAP_REGION_UPDATE_MIN_PLAYERS] = sConfigMgr->GetOption<int32>("MapUpdate.Regions.MinPlayers", 100);
+    m_int_configs[CONFIG_LOAD_THREADS]               = sConfigMgr->GetOption<int32>("LoadThreads", 1);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1344,6 +1362,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PDUMP_NO_PATHS]     = sConfigMgr->GetOption<bool>("PlayerDump.DisallowPaths", true);
     m_bool_configs[CONFIG_PDUMP_NO_OVERWRITE] = sConfigMgr->GetOption<bool>("PlayerDump.DisallowOverwrite", true);
     m_bool_configs[CONFIG_ENABLE_MMAPS]       = sConfigMgr->GetOption<bool>("MoveMaps.Enable", true);
+    m_int_configs[CONFIG_MMAP_PATH_BUDGET]    = sConfigMgr->GetOption<int32>("MoveMaps.PathBudget", 0);
+    m_int_configs[CONFIG_MMAP_PATH_THREADS]   = sConfigMgr->GetOption<int32>("MoveMaps.PathThreads", 0);
     MMAP::MMapFactory::InitializeDisabledMaps();
 
     // Wintergrasp
@@ -1571,122 +1591,247 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server", " ");
 
-    LOG_INFO("server", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    ///- Loaders of the same graph run concurrently on LoadThreads threads once their dependencies are done
+    uint32 loadThreads = std::max<uint32>(getIntConfig(CONFIG_LOAD_THREADS), 1);
+    Acore::TaskGraph loadGraph;
 
-    LOG_INFO("server", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    loadGraph.Add("page texts", []()
+    {
+        LOG_INFO("server", "Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    LOG_INFO("server", "Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    loadGraph.Add("gameobject templates", []()
+    {
+        LOG_INFO("server", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    }, { "page texts" });
 
-    LOG_INFO("server", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    loadGraph.Add("gameobject template addons", []()
+    {
+        LOG_INFO("server", "Loading Game Object template addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
+    }, { "gameobject templates" });
 
-    LOG_INFO("server", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    loadGraph.Add("transport templates", []()
+    {
+        LOG_INFO("server", "Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+    }, { "gameobject templates" });
 
-    LOG_INFO("server", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+    loadGraph.Add("spell required", []()
+    {
+        LOG_INFO("server", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
+    });
 
-    LOG_INFO("server", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    loadGraph.Add("spell groups", []()
+    {
+        LOG_INFO("server", "Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
+    });
 
-    LOG_INFO("server", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    loadGraph.Add("spell learn skills", []()
+    {
+        LOG_INFO("server", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();
+    });
 
-    LOG_INFO("server", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    loadGraph.Add("spell proc events", []()
+    {
+        LOG_INFO("server", "Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
+    });
 
-    LOG_INFO("server", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+    loadGraph.Add("spell procs", []()
+    {
+        LOG_INFO("server", "Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
+    });
 
-    LOG_INFO("server", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    loadGraph.Add("spell bonus", []()
+    {
+        LOG_INFO("server", "Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonusess();
+    });
 
-    LOG_INFO("server", "Loading Mixology bonuses...");
-    sSpellMgr->LoadSpellMixology();
+    loadGraph.Add("spell threats", []()
+    {
+        LOG_INFO("server", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
+    });
 
-    LOG_INFO("server", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    loadGraph.Add("spell mixology", []()
+    {
+        LOG_INFO("server", "Loading Mixology bonuses...");
+        sSpellMgr->LoadSpellMixology();
+    });
 
-    LOG_INFO("server", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    loadGraph.Add("spell group stack rules", []()
+    {
+        LOG_INFO("server", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
+    }, { "spell groups" });
 
-    LOG_INFO("server", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    loadGraph.Add("npc texts", []()
+    {
+        LOG_INFO("server", "Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    LOG_INFO("server", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loadGraph.Add("spell enchant proc data", []()
+    {
+        LOG_INFO("server", "Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    });
 
-    LOG_INFO("server", "Loading Disables");
-    DisableMgr::LoadDisables();                                  // must be before loading quests and items
+    loadGraph.Add("item random enchantments", []()
+    {
+        LOG_INFO("server", "Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    LOG_INFO("server", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    loadGraph.Add("disables", []()
+    {
+        LOG_INFO("server", "Loading Disables");
+        DisableMgr::LoadDisables();
+    });
 
-    LOG_INFO("server", "Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
+    loadGraph.Add("items", []()
+    {
+        LOG_INFO("server", "Loading Items...");
+        sObjectMgr->LoadItemTemplates();
+    }, { "page texts", "item random enchantments", "disables" });
 
-    LOG_INFO("server", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+    loadGraph.Add("item set names", []()
+    {
+        LOG_INFO("server", "Loading Item set names...");
+        sObjectMgr->LoadItemSetNames();
+    }, { "items" });
 
-    LOG_INFO("server", "Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
+    loadGraph.Add("creature model info", []()
+    {
+        LOG_INFO("server", "Loading Creature Model Based Info Data...");
+        sObjectMgr->LoadCreatureModelInfo();
+    });
 
-    LOG_INFO("server", "Loading Equipment templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
+    loadGraph.Add("creature templates", []()
+    {
+        LOG_INFO("server", "Loading Creature templates...");
+        sObjectMgr->LoadCreatureTemplates();
+    }, { "creature model info", "disables" });
 
-    LOG_INFO("server", "Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
+    loadGraph.Add("equipment templates", []()
+    {
+        LOG_INFO("server", "Loading Equipment templates...");
+        sObjectMgr->LoadEquipmentTemplates();
+    }, { "creature templates", "items" });
 
-    LOG_INFO("server", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+    loadGraph.Add("creature template addons", []()
+    {
+        LOG_INFO("server", "Loading Creature template addons...");
+        sObjectMgr->LoadCreatureTemplateAddons();
+    }, { "creature templates" });
 
-    LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    loadGraph.Add("reputation reward rates", []()
+    {
+        LOG_INFO("server", "Loading Reputation Reward Rates...");
+        sObjectMgr->LoadReputationRewardRate();
+    });
 
-    LOG_INFO("server", "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    loadGraph.Add("reputation on kill", []()
+    {
+        LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
+        sObjectMgr->LoadReputationOnKill();
+    }, { "creature templates" });
 
-    LOG_INFO("server", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    loadGraph.Add("reputation spillover", []()
+    {
+        LOG_INFO("server", "Loading Reputation Spillover Data..." );
+        sObjectMgr->LoadReputationSpilloverTemplate();
+    });
 
-    LOG_INFO("server", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    loadGraph.Add("points of interest", []()
+    {
+        LOG_INFO("server", "Loading Points Of Interest Data...");
+        sObjectMgr->LoadPointsOfInterest();
+    });
 
-    LOG_INFO("server", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    loadGraph.Add("creature base stats", []()
+    {
+        LOG_INFO("server", "Loading Creature Base Stats...");
+        sObjectMgr->LoadCreatureClassLevelStats();
+    }, { "creature templates" });
 
-    LOG_INFO("server", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    // the spawn mask check of creatures on transport maps reads the transport maps found by LoadGameObjectTemplate
+    loadGraph.Add("creatures", []()
+    {
+        LOG_INFO("server", "Loading Creature Data...");
+        sObjectMgr->LoadCreatures();
+    }, { "creature templates", "equipment templates", "gameobject templates" });
 
-    LOG_INFO("server", "Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
+    loadGraph.Add("temporary summons", []()
+    {
+        LOG_INFO("server", "Loading Temporary Summon Data...");
+        sObjectMgr->LoadTempSummons();
+    }, { "creature templates", "gameobject templates" });
 
-    LOG_INFO("server", "Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
+    loadGraph.Add("pet levelup spells", []()
+    {
+        LOG_INFO("server", "Loading pet levelup spells...");
+        sSpellMgr->LoadPetLevelupSpellMap();
+    });
 
-    LOG_INFO("server", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    loadGraph.Add("pet default spells", []()
+    {
+        LOG_INFO("server", "Loading pet default spells additional to levelup spells...");
+        sSpellMgr->LoadPetDefaultSpells();
+    }, { "pet levelup spells", "creature templates" });
 
-    LOG_INFO("server", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    loadGraph.Add("creature addons", []()
+    {
+        LOG_INFO("server", "Loading Creature Addon Data...");
+        sObjectMgr->LoadCreatureAddons();
+    }, { "creatures" });
 
-    LOG_INFO("server", "Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    // creatures and gameobjects share the grid guid store of ObjectMgr
+    loadGraph.Add("gameobjects", []()
+    {
+        LOG_INFO("server", "Loading Gameobject Data...");
+        sObjectMgr->LoadGameobjects();
+    }, { "gameobject templates", "transport templates", "creatures" });
 
-    LOG_INFO("server", "Loading GameObject Quest Items...");
-    sObjectMgr->LoadGameObjectQuestItems();
+    loadGraph.Add("gameobject addons", []()
+    {
+        LOG_INFO("server", "Loading GameObject Addon Data...");
+        sObjectMgr->LoadGameObjectAddons();
+    }, { "gameobjects" });
 
-    LOG_INFO("server", "Loading Creature Quest Items...");
-    sObjectMgr->LoadCreatureQuestItems();
+    loadGraph.Add("gameobject quest items", []()
+    {
+        LOG_INFO("server", "Loading GameObject Quest Items...");
+        sObjectMgr->LoadGameObjectQuestItems();
+    }, { "gameobject templates", "items" });
 
-    LOG_INFO("server", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    loadGraph.Add("creature quest items", []()
+    {
+        LOG_INFO("server", "Loading Creature Quest Items...");
+        sObjectMgr->LoadCreatureQuestItems();
+    }, { "creature templates", "items" });
 
-    LOG_INFO("server", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
+    loadGraph.Add("linked respawn", []()
+    {
+        LOG_INFO("server", "Loading Creature Linked Respawn...");
+        sObjectMgr->LoadLinkedRespawn();
+    }, { "creatures", "gameobjects" });
+
+    loadGraph.Add("weather", []()
+    {
+        LOG_INFO("server", "Loading Weather Data...");
+        WeatherMgr::LoadWeatherData();
+    });
+
+    loadGraph.Run(loadThreads);
 
     LOG_INFO("server", "Loading Quests...");
     sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
@@ -1781,33 +1926,62 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", "Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
-
-    LOG_INFO("server", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    LOG_INFO("server", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    LOG_INFO("server", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    LOG_INFO("server", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    LOG_INFO("server", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    LOG_INFO("server", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    // Loot tables, the reference loot is checked against all other loot stores
+    loadGraph.Add("creature loot", &LoadLootTemplates_Creature);
+    loadGraph.Add("fishing loot", &LoadLootTemplates_Fishing);
+    loadGraph.Add("gameobject loot", &LoadLootTemplates_Gameobject);
+    loadGraph.Add("item loot", &LoadLootTemplates_Item);
+    loadGraph.Add("mail loot", &LoadLootTemplates_Mail);
+    loadGraph.Add("milling loot", &LoadLootTemplates_Milling);
+    loadGraph.Add("pickpocketing loot", &LoadLootTemplates_Pickpocketing);
+    loadGraph.Add("skinning loot", &LoadLootTemplates_Skinning);
+    loadGraph.Add("disenchant loot", &LoadLootTemplates_Disenchant);
+    loadGraph.Add("prospecting loot", &LoadLootTemplates_Prospecting);
+    loadGraph.Add("spell loot", &LoadLootTemplates_Spell);
+    loadGraph.Add("reference loot", &LoadLootTemplates_Reference, { "creature loot", "fishing loot", "gameobject loot", "item loot", "mail loot",
+        "milling loot", "pickpocketing loot", "skinning loot", "disenchant loot", "prospecting loot", "spell loot" });
+
+    loadGraph.Add("skill discovery", []()
+    {
+        LOG_INFO("server", "Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
+
+    loadGraph.Add("skill extra items", []()
+    {
+        LOG_INFO("server", "Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
+
+    loadGraph.Add("skill perfect items", []()
+    {
+        LOG_INFO("server", "Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
+    });
+
+    loadGraph.Add("fishing base skill", []()
+    {
+        LOG_INFO("server", "Loading Skill Fishing base level requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
+
+    loadGraph.Add("achievements", []()
+    {
+        LOG_INFO("server", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+        LOG_INFO("server", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+        LOG_INFO("server", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        LOG_INFO("server", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        LOG_INFO("server", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+        LOG_INFO("server", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
+
+    loadGraph.Run(loadThreads);
 
     ///- Load dynamic data tables from the database
     LOG_INFO("server", "Loading Item Auctions...");
@@ -1832,29 +2006,55 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", "Loading BattleMasters...");
     sBattlegroundMgr->LoadBattleMastersEntry();
 
-    LOG_INFO("server", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loadGraph.Add("game teleports", []()
+    {
+        LOG_INFO("server", "Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
+
+    loadGraph.Add("gossip menus", []()
+    {
+        LOG_INFO("server", "Loading Gossip menu...");
+        sObjectMgr->LoadGossipMenu();
+    });
 
-    LOG_INFO("server", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
+    loadGraph.Add("gossip menu options", []()
+    {
+        LOG_INFO("server", "Loading Gossip menu options...");
+        sObjectMgr->LoadGossipMenuItems();
+    }, { "gossip menus" });
 
-    LOG_INFO("server", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
+    loadGraph.Add("vendors", []()
+    {
+        LOG_INFO("server", "Loading Vendors...");
+        sObjectMgr->LoadVendors();
+    });
 
-    LOG_INFO("server", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    loadGraph.Add("trainers", []()
+    {
+        LOG_INFO("server", "Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();
+    });
 
-    LOG_INFO("server", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    loadGraph.Add("waypoints", []()
+    {
+        LOG_INFO("server", "Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    LOG_INFO("server", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    loadGraph.Add("smartai waypoints", []()
+    {
+        LOG_INFO("server", "Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    LOG_INFO("server", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    loadGraph.Add("creature formations", []()
+    {
+        LOG_INFO("server", "Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    LOG_INFO("server", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    loadGraph.Run(loadThreads);
 
     LOG_INFO("server", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
@@ -1971,6 +2171,9 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server", " ");
     sMapMgr->Initialize();
 
+    if (m_bool_configs[CONFIG_ENABLE_MMAPS] && m_int_configs[CONFIG_MMAP_PATH_THREADS] > 0)
+        sPathSearchPool->Start(m_int_configs[CONFIG_MMAP_PATH_THREADS]);
+
     LOG_INFO("server", "Starting Game Event system...");
     LOG_INFO("server", " ");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
@@ -2079,6 +2282,8 @@ void World::SetInitialWorldSettings()
         }
     }
 
+    sWorldDataCache->EndStartup();
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
     LOG_INFO("server", " ");
     LOG_INFO("server", "WORLD: World initialized in %u minutes %u seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000)); // outError for red color in console
@@ -2172,6 +2377,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    UpdateProfilerScope profileWorld(UPDATE_SECTION_WORLD);
+
     m_updateTime = diff;
 
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE])
@@ -2237,6 +2444,7 @@ void World::Update(uint32 diff)
     // so we don't have to do it in every packet that modifies auctions
     AsyncAuctionListingMgr::SetAuctionListingAllowed(false);
     {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_SESSIONS);
         std::lock_guard<std::mutex> guard(AsyncAuctionListingMgr::GetLock());
 
         // pussywizard: handle auctions when the timer has passed
@@ -2284,9 +2492,15 @@ void World::Update(uint32 diff)
         }
     }
 
-    sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff before finding compatibility during map update
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_LFG);
+        sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff before finding compatibility during map update
+    }
 
-    sMapMgr->Update(diff);
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_MAPS);
+        sMapMgr->Update(diff);
+    }
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
@@ -2297,16 +2511,27 @@ void World::Update(uint32 diff)
         }
     }
 
-    sBattlegroundMgr->Update(diff);
-
-    sOutdoorPvPMgr->Update(diff);
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_BATTLEGROUNDS);
+        sBattlegroundMgr->Update(diff);
+    }
 
-    sBattlefieldMgr->Update(diff);
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_OUTDOORPVP);
+        sOutdoorPvPMgr->Update(diff);
+        sBattlefieldMgr->Update(diff);
+    }
 
-    sLFGMgr->Update(diff, 2); // pussywizard: handle created proposals
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_LFG);
+        sLFGMgr->Update(diff, 2); // pussywizard: handle created proposals
+    }
 
     // execute callbacks from sql queries that were queued recently
-    ProcessQueryCallbacks();
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_QUERY_CALLBACKS);
+        ProcessQueryCallbacks();
+    }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -2339,6 +2564,7 @@ void World::Update(uint32 diff)
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
     {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_GAME_EVENTS);
         m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
         uint32 nextGameEvent = sGameEventMgr->Update();
         m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
@@ -2358,12 +2584,21 @@ void World::Update(uint32 diff)
     }
 
     // update the instance reset times
-    sInstanceSaveMgr->Update();
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_INSTANCE_RESETS);
+        sInstanceSaveMgr->Update();
+    }
 
     // And last, but not least handle the issued cli commands
-    ProcessCliCommands();
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_CLI_COMMANDS);
+        ProcessCliCommands();
+    }
 
-    sScriptMgr->OnWorldUpdate(diff);
+    {
+        UpdateProfilerScope profile(UPDATE_SECTION_WORLD_SCRIPTS);
+        sScriptMgr->OnWorldUpdate(diff);
+    }
 
     SavingSystemMgr::Update(diff);
 }
@@ -14,15 +14,19 @@ EndScriptData */
 #include "AvgDiffTracker.h"
 #include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "GitRevision.h"
 #include "Language.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
+#include "PacketProcessingStats.h"
 #include "Player.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
 #include "ServerMotd.h"
 #include "StringConvert.h"
+#include "UpdateData.h"
+#include "UpdateProfiler.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include <boost/filesystem/operations.hpp>
@@ -70,6 +74,14 @@ public:
             { "closed",         SEC_CONSOLE,        true,  &HandleServerSetClosedCommand,           "" }
         };
 
+        static std::vector<ChatCommand> serverPerfCommandTable =
+        {
+            { "on",             SEC_ADMINISTRATOR,  true,  &HandleServerPerfOnCommand,              "" },
+            { "off",            SEC_ADMINISTRATOR,  true,  &HandleServerPerfOffCommand,             "" },
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerPerfResetCommand,           "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerPerfCommand,                "" }
+        };
+
         static std::vector<ChatCommand> serverCommandTable =
         {
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "" },
@@ -79,6 +91,7 @@ public:
             { "idleshutdown",   SEC_CONSOLE,        true,  nullptr,                                 "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                "" },
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                "" },
+            { "perf",           SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverPerfCommandTable },
             { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverShutdownCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverSetCommandTable }
@@ -207,6 +220,87 @@ public:
         return true;
     }
 
+    static std::string FormatProfilerEntry(char const* name, UpdateProfilerEntry const& entry)
+    {
+        std::string buckets;
+        for (uint32 i = 0; i < MAX_UPDATE_PROFILER_BUCKETS; ++i)
+        {
+            uint32 limit = UpdateProfiler::GetBucketLimitUs(UpdateProfilerBucket(i));
+            if (limit)
+                buckets += Acore::StringFormat(" <%.1fms:" UI64FMTD, limit / 1000.0f, entry.Buckets[i]);
+            else
+                buckets += Acore::StringFormat(" slow:" UI64FMTD, entry.Buckets[i]);
+        }
+
+        return Acore::StringFormat("%s: " UI64FMTD " calls, avg %.2f ms, max %.2f ms,%s", name, entry.Count,
+            entry.Count ? entry.TotalUs / 1000.0f / entry.Count : 0.0f, entry.MaxUs / 1000.0f, buckets.c_str());
+    }
+
+    static bool HandleServerPerfCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        handler->PSendSysMessage("Update profiler is %s.", sUpdateProfiler->IsEnabled() ? "enabled" : "disabled (.server perf on)");
+
+        for (uint32 i = 0; i < MAX_UPDATE_SECTIONS; ++i)
+        {
+            UpdateProfilerSection section = UpdateProfilerSection(i);
+            bool child = UpdateProfiler::GetParentSection(section) != section;
+            std::string name = Acore::StringFormat("%s%s", child ? "  " : "", UpdateProfiler::GetSectionName(section));
+            handler->SendSysMessage(FormatProfilerEntry(name.c_str(), sUpdateProfiler->GetStats(section)).c_str());
+        }
+
+        for (UpdateProfilerMapEntry const& entry : sUpdateProfiler->GetTopMaps(5))
+        {
+            std::string name = Acore::StringFormat("Map %u", entry.MapId);
+            handler->SendSysMessage(FormatProfilerEntry(name.c_str(), entry).c_str());
+        }
+
+        for (PacketProcessingStatsEntry const& entry : sPacketProcessingStats->GetTopOpcodes(5))
+        {
+            handler->PSendSysMessage("%s: " UI64FMTD " packets, avg " UI64FMTD " us, max " UI64FMTD " us",
+                GetOpcodeNameForLogging(Opcodes(entry.Opcode)).c_str(), entry.Count, entry.TotalUs / entry.Count, entry.MaxUs);
+        }
+
+        UpdateDataCompressionStats compression = UpdateData::GetCompressionStats();
+        handler->PSendSysMessage("Compressed update packets: " UI64FMTD ", bytes in: " UI64FMTD ", bytes out: " UI64FMTD ", compression time: " UI64FMTD " ms",
+            compression.Packets, compression.BytesIn, compression.BytesOut, compression.TimeUs / IN_MILLISECONDS);
+
+        auto sendQueueStats = [handler](char const* name, SQLOperationQueueStats const& stats)
+        {
+            handler->PSendSysMessage("%s DB async queue: " UI64FMTD " pending (peak " UI64FMTD "), " UI64FMTD " executed, wait avg " UI64FMTD " us / max " UI64FMTD " us",
+                name, stats.Size, stats.PeakSize, stats.Executed, stats.Executed ? stats.TotalWaitUs / stats.Executed : 0, stats.MaxWaitUs);
+        };
+
+        sendQueueStats("World", WorldDatabase.GetQueueStats());
+        sendQueueStats("Character", CharacterDatabase.GetQueueStats());
+        sendQueueStats("Auth", LoginDatabase.GetQueueStats());
+        return true;
+    }
+
+    static bool HandleServerPerfOnCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sUpdateProfiler->SetEnabled(true);
+        handler->SendSysMessage("Update profiler enabled.");
+        return true;
+    }
+
+    static bool HandleServerPerfOffCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sUpdateProfiler->SetEnabled(false);
+        handler->SendSysMessage("Update profiler disabled.");
+        return true;
+    }
+
+    static bool HandleServerPerfResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sUpdateProfiler->Reset();
+        sPacketProcessingStats->Reset();
+        WorldDatabase.ResetQueueStats();
+        CharacterDatabase.ResetQueueStats();
+        LoginDatabase.ResetQueueStats();
+        handler->SendSysMessage("Update profiler, packet and database queue statistics reset.");
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
     {
         std::string realmName = sWorld->GetRealmName();
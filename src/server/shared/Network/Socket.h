@@ -8,19 +8,27 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 106600
+#include <boost/asio/post.hpp>
+#endif
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
-#ifdef BOOST_ASIO_HAS_IOCP
-#define AC_SOCKET_USE_IOCP
-#endif
+
+// upper limits of a single gathered write, the rest of the queue is sent by the next write
+#define WRITE_GATHER_MAX_BUFFERS 64
+#define WRITE_GATHER_MAX_SIZE 65536
 
 template<class T>
 class Socket : public std::enable_shared_from_this<T>
@@ -48,16 +56,13 @@ public:
             return false;
         }
 
-#ifndef AC_SOCKET_USE_IOCP
-        if (_isWritingAsync || (_writeQueue.empty() && !_closing))
+        // writes are started as soon as data is queued, only a delayed close with nothing left to send is handled here
+        if (_closing && !_isWritingAsync && _writeQueue.empty())
         {
-            return true;
+            CloseSocket();
+            return false;
         }
 
-        for (; HandleQueue();)
-            ;
-#endif
-
         return true;
     }
 
@@ -99,13 +104,12 @@ public:
             std::bind(callback, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
     }
 
+    /// Must be called from the thread running the io context of this socket, use PostToSocketContext from other threads
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
-#ifdef AC_SOCKET_USE_IOCP
         AsyncProcessQueue();
-#endif
     }
 
     bool IsOpen() const { return !_closed && !_closing; }
@@ -136,20 +140,39 @@ protected:
 
     bool AsyncProcessQueue()
     {
-        if (_isWritingAsync)
+        if (_isWritingAsync || _writeQueue.empty())
             return false;
 
         _isWritingAsync = true;
 
-#ifdef AC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        // gather the queued buffers into a single send instead of one syscall per buffer
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(std::min<std::size_t>(_writeQueue.size(), WRITE_GATHER_MAX_BUFFERS));
+
+        std::size_t bytesToSend = 0;
+        for (MessageBuffer& buffer : _writeQueue)
+        {
+            if (buffers.size() >= WRITE_GATHER_MAX_BUFFERS || bytesToSend >= WRITE_GATHER_MAX_SIZE)
+                break;
+
+            buffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytesToSend += buffer.GetActiveSize();
+        }
+
+        _socket.async_write_some(buffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
+
+        return true;
+    }
+
+    template<typename Handler>
+    void PostToSocketContext(Handler&& handler)
+    {
+#if BOOST_VERSION >= 106600
+        boost::asio::post(_socket.get_executor(), std::forward<Handler>(handler));
 #else
-        _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
-            this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
+        _socket.get_io_service().post(std::forward<Handler>(handler));
 #endif
-        return false;
     }
 
     void SetNoDelay(bool enable)
@@ -175,89 +198,35 @@ private:
         ReadHandler();
     }
 
-#ifdef AC_SOCKET_USE_IOCP
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
-    {
-        if (!error)
-        {
-            _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
-
-            if (!_writeQueue.empty())
-                AsyncProcessQueue();
-            else if (_closing)
-                CloseSocket();
-        }
-        else
-            CloseSocket();
-    }
-
-#else
-
-    void WriteHandlerWrapper(boost::system::error_code /*error*/, std::size_t /*transferedBytes*/)
     {
         _isWritingAsync = false;
-        HandleQueue();
-    }
-
-    bool HandleQueue()
-    {
-        if (_writeQueue.empty())
-            return false;
-
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
-
-        boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
 
         if (error)
         {
-            if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
-            {
-                return AsyncProcessQueue();
-            }
-
-            _writeQueue.pop();
-
-            if (_closing && _writeQueue.empty())
-            {
-                CloseSocket();
-            }
-
-            return false;
+            CloseSocket();
+            return;
         }
-        else if (bytesSent == 0)
-        {
-            _writeQueue.pop();
-
-            if (_closing && _writeQueue.empty())
-            {
-                CloseSocket();
-            }
 
-            return false;
-        }
-        else if (bytesSent < bytesToSend) // now n > 0
+        // a gathered write may complete several buffers and leave the last one partially sent
+        while (!_writeQueue.empty())
         {
-            queuedMessage.ReadCompleted(bytesSent);
-            return AsyncProcessQueue();
-        }
+            MessageBuffer& buffer = _writeQueue.front();
+            std::size_t consumed = std::min(transferedBytes, buffer.GetActiveSize());
+            buffer.ReadCompleted(consumed);
+            transferedBytes -= consumed;
 
-        _writeQueue.pop();
+            if (buffer.GetActiveSize())
+                break;
 
-        if (_closing && _writeQueue.empty())
-        {
-            CloseSocket();
+            _writeQueue.pop_front();
         }
 
-        return !_writeQueue.empty();
+        if (!_writeQueue.empty())
+            AsyncProcessQueue();
+        else if (_closing)
+            CloseSocket();
     }
-#endif
 
     tcp::socket _socket;
 
@@ -265,7 +234,7 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
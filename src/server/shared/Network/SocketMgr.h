@@ -61,7 +61,8 @@ public:
 
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        if (_acceptor)
+            _acceptor->Close();
 
         if (_threadCount != 0)
             for (int32 i = 0; i < _threadCount; ++i)
@@ -11,7 +11,7 @@
 #include "Util.h"
 
 RealmList::RealmList() :
-    _updateInterval(0) { }
+    _realms(std::make_shared<RealmMap const>()), _updateInterval(0), _nextUpdateTime(0) { }
 
 RealmList* RealmList::instance()
 {
@@ -71,12 +71,11 @@ void RealmList::LoadBuildInfo()
     }
 }
 
-void RealmList::UpdateRealm(RealmHandle const& id, uint32 build, std::string const& name,
+void RealmList::UpdateRealm(RealmMap& realms, RealmHandle const& id, uint32 build, std::string const& name,
     ACE_INET_Addr&& address, ACE_INET_Addr&& localAddr, ACE_INET_Addr&& localSubmask,
     uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population)
 {
-    // Create new if not exist or update existed
-    Realm& realm = _realms[id];
+    Realm& realm = realms[id];
 
     realm.Id = id;
     realm.Build = build;
@@ -87,20 +86,9 @@ void RealmList::UpdateRealm(RealmHandle const& id, uint32 build, std::string con
     realm.AllowedSecurityLevel = allowedSecurityLevel;
     realm.PopulationLevel = population;
 
-    if (!realm.ExternalAddress || *realm.ExternalAddress != address)
-    {
-        realm.ExternalAddress = std::make_unique<ACE_INET_Addr>(std::move(address));
-    }
-
-    if (!realm.LocalAddress || *realm.LocalAddress != localAddr)
-    {
-        realm.LocalAddress = std::make_unique<ACE_INET_Addr>(std::move(localAddr));
-    }
-
-    if (!realm.LocalSubnetMask || *realm.LocalSubnetMask != localSubmask)
-    {
-        realm.LocalSubnetMask = std::make_unique<ACE_INET_Addr>(std::move(localSubmask));
-    }
+    realm.ExternalAddress = std::make_unique<ACE_INET_Addr>(std::move(address));
+    realm.LocalAddress = std::make_unique<ACE_INET_Addr>(std::move(localAddr));
+    realm.LocalSubnetMask = std::make_unique<ACE_INET_Addr>(std::move(localSubmask));
 
     realm.Port = port;
 }
@@ -127,12 +115,13 @@ void RealmList::UpdateRealms()
     PreparedQueryResult result = LoginDatabase.Query(stmt);
 
     std::map<RealmHandle, std::string> existingRealms;
-    for (auto const& [handle, realm] : _realms)
+    for (auto const& [handle, realm] : *GetRealms())
     {
         existingRealms[handle] = realm.Name;
     }
 
-    _realms.clear();
+    // network threads keep reading the old list while the new one is built
+    std::shared_ptr<RealmMap> realms = std::make_shared<RealmMap>();
 
     // Circle through results and add them to the realm map
     if (result)
@@ -188,7 +177,7 @@ void RealmList::UpdateRealms()
 
             RealmHandle id{ realmId };
 
-            UpdateRealm(id, build, name, std::move(externalAddress.value()), std::move(localAddress.value()), std::move(localSubmask.value()), port, icon, flag,
+            UpdateRealm(*realms, id, build, name, std::move(externalAddress.value()), std::move(localAddress.value()), std::move(localSubmask.value()), port, icon, flag,
                 timezone, (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR), pop);
 
             if (!existingRealms.count(id))
@@ -203,17 +192,15 @@ void RealmList::UpdateRealms()
             existingRealms.erase(id);
         } while (result->NextRow());
     }
+
+    std::lock_guard<std::mutex> guard(_realmsLock);
+    _realms = std::move(realms);
 }
 
-Realm const* RealmList::GetRealm(RealmHandle const& id) const
+RealmList::RealmMapSnapshot RealmList::GetRealms() const
 {
-    auto itr = _realms.find(id);
-    if (itr != _realms.end())
-    {
-        return &itr->second;
-    }
-
-    return nullptr;
+    std::lock_guard<std::mutex> guard(_realmsLock);
+    return _realms;
 }
 
 RealmBuildInfo const* RealmList::GetBuildInfo(uint32 build) const
@@ -11,6 +11,8 @@
 #include "Realm.h"
 #include <array>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_set>
 
@@ -30,6 +32,7 @@ class AC_SHARED_API RealmList
 {
 public:
     typedef std::map<RealmHandle, Realm> RealmMap;
+    typedef std::shared_ptr<RealmMap const> RealmMapSnapshot;
 
     RealmList();
     ~RealmList() = default;
@@ -39,20 +42,21 @@ public:
     void Initialize(uint32 updateInterval);
     void UpdateIfNeed();
 
-    RealmMap const& GetRealms() const { return _realms; }
-    Realm const* GetRealm(RealmHandle const& id) const;
+    /// The returned map is never modified, updates replace it with a new one
+    RealmMapSnapshot GetRealms() const;
 
     RealmBuildInfo const* GetBuildInfo(uint32 build) const;
 
 private:
     void LoadBuildInfo();
     void UpdateRealms();
-    void UpdateRealm(RealmHandle const& id, uint32 build, std::string const& name,
+    void UpdateRealm(RealmMap& realms, RealmHandle const& id, uint32 build, std::string const& name,
         ACE_INET_Addr&& address, ACE_INET_Addr&& localAddr, ACE_INET_Addr&& localSubmask,
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
 
     std::vector<RealmBuildInfo> _builds;
-    RealmMap _realms;
+    mutable std::mutex _realmsLock;
+    RealmMapSnapshot _realms;
     uint32 _updateInterval;
     time_t _nextUpdateTime;
 };
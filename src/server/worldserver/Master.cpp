@@ -29,7 +29,6 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldRunnable.h"
-#include "WorldSocket.h"
 #include "WorldSocketMgr.h"
 #include "DatabaseLoader.h"
 #include "Optional.h"
@@ -160,8 +159,38 @@ int Master::Run()
     signalHandler.handle_signal(SIGBREAK, &HandleSignal);
 #endif
 
+    // Start the Remote Access port (acceptor) if enabled
+    std::unique_ptr<AsyncAcceptor> raAcceptor;
+    if (sConfigMgr->GetOption<bool>("Ra.Enable", false))
+        raAcceptor.reset(StartRaSocketAcceptor(*ioContext));
+
+    ///- Launch the world listener socket
+    uint16 worldPort = uint16(sWorld->getIntConfig(CONFIG_PORT_WORLD));
+    std::string bindIp = sConfigMgr->GetOption<std::string>("BindIP", "0.0.0.0");
+    if (!sWorldSocketMgr->StartNetwork(*ioContext, bindIp, worldPort, sConfigMgr->GetOption<int32>("Network.Threads", 1)))
+    {
+        LOG_ERROR("server", "Failed to start network");
+        World::StopNow(ERROR_EXIT_CODE);
+        // go down and shutdown the server
+    }
+
+    // Run the acceptors of the world and remote access sockets, connections are handed over to the network threads
+    std::shared_ptr<std::thread> ioContextThread(new std::thread([ioContext]() { ioContext->run(); }),
+        [ioContext](std::thread* thr)
+    {
+        ioContext->stop();
+        thr->join();
+        delete thr;
+    });
+
     ///- Launch WorldRunnable thread
-    Acore::Thread worldThread(new WorldRunnable);
+    // the world thread closes the network before the world is torn down, so no session can be added to a dying world
+    Acore::Thread worldThread(new WorldRunnable([&ioContextThread]()
+    {
+        // stop accepting before the acceptors are destroyed, then close the client connections
+        ioContextThread.reset();
+        sWorldSocketMgr->StopNetwork();
+    }));
     worldThread.setPriority(Acore::Priority_Highest);
 
     Acore::Thread* cliThread = nullptr;
@@ -180,11 +209,6 @@ int Master::Run()
     Acore::Thread auctionLising_thread(new AuctionListingRunnable);
     auctionLising_thread.setPriority(Acore::Priority_High);
 
-    // Start the Remote Access port (acceptor) if enabled
-    std::unique_ptr<AsyncAcceptor> raAcceptor;
-    if (sConfigMgr->GetOption<bool>("Ra.Enable", false))
-        raAcceptor.reset(StartRaSocketAcceptor(*ioContext));
-
     // Start soap serving thread if enabled
     std::shared_ptr<std::thread> soapThread;
     if (sConfigMgr->GetOption<bool>("SOAP.Enabled", false))
@@ -206,16 +230,6 @@ int Master::Run()
         freezeThread->setPriority(Acore::Priority_Highest);
     }
 
-    ///- Launch the world listener socket
-    uint16 worldPort = uint16(sWorld->getIntConfig(CONFIG_PORT_WORLD));
-    std::string bindIp = sConfigMgr->GetOption<std::string>("BindIP", "0.0.0.0");
-    if (sWorldSocketMgr->StartNetwork(worldPort, bindIp.c_str()) == -1)
-    {
-        LOG_ERROR("server", "Failed to start network");
-        World::StopNow(ERROR_EXIT_CODE);
-        // go down and shutdown the server
-    }
-
     // set server online (allow connecting now)
     LoginDatabase.DirectPExecute("UPDATE realmlist SET flag = flag & ~%u, population = 0 WHERE id = '%u'", REALM_FLAG_VERSION_MISMATCH, realm.Id.Realm);
 
@@ -351,6 +365,9 @@ bool Master::_StartDB()
 
 void Master::_StopDB()
 {
+    // write the queued log messages while the DB appenders can still insert them
+    sLog->SetSynchronous();
+
     CharacterDatabase.Close();
     WorldDatabase.Close();
     LoginDatabase.Close();
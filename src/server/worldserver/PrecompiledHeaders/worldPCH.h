@@ -1,4 +1,4 @@
-#include "WorldSocket.h"        // must be first to make ACE happy with ACE includes in it
+#include "WorldSocket.h"
 
 #include "Common.h"
 #include "Configuration/Config.h"
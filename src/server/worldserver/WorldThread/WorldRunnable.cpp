@@ -20,7 +20,6 @@
 #include "Timer.h"
 #include "World.h"
 #include "WorldRunnable.h"
-#include "WorldSocketMgr.h"
 
 #ifdef ELUNA
 #include "LuaEngine.h"
@@ -72,7 +71,7 @@ void WorldRunnable::run()
     // unload battleground templates before different singletons destroyed
     sBattlegroundMgr->DeleteAllBattlegrounds();
 
-    sWorldSocketMgr->StopNetwork();
+    _stopNetwork();
 
     sMapMgr->UnloadAll();                     // unload all grids (including locked in memory)
     sOutdoorPvPMgr->Die();
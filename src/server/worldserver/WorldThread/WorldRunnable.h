@@ -12,12 +12,18 @@
 #define __WORLDRUNNABLE_H
 
 #include "Threading.h"
+#include <functional>
 
 /// Heartbeat thread for the World
 class WorldRunnable : public Acore::Runnable
 {
 public:
+    explicit WorldRunnable(std::function<void()> stopNetwork) : _stopNetwork(std::move(stopNetwork)) { }
+
     void run() override;
+
+private:
+    std::function<void()> _stopNetwork;                     // closes the acceptors and client connections on shutdown
 };
 
 class AuctionListingRunnable : public Acore::Runnable
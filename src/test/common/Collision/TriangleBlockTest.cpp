@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "TriangleBlock.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+
+using namespace VMAP;
+
+namespace
+{
+    G3D::Vector3 RandomPoint(std::mt19937& rng, float range)
+    {
+        std::uniform_real_distribution<float> coord(-range, range);
+        return G3D::Vector3(coord(rng), coord(rng), coord(rng));
+    }
+
+    // true if the ray passes within rounding distance of an edge of the triangle, or ends there
+    bool IsBorderline(G3D::Vector3 const* triangle, G3D::Ray const& ray, float distance)
+    {
+        double const ox = ray.origin().x, oy = ray.origin().y, oz = ray.origin().z;
+        double const dx = ray.direction().x, dy = ray.direction().y, dz = ray.direction().z;
+        double const e1x = triangle[1].x - triangle[0].x, e1y = triangle[1].y - triangle[0].y, e1z = triangle[1].z - triangle[0].z;
+        double const e2x = triangle[2].x - triangle[0].x, e2y = triangle[2].y - triangle[0].y, e2z = triangle[2].z - triangle[0].z;
+        double const px = dy * e2z - dz * e2y, py = dz * e2x - dx * e2z, pz = dx * e2y - dy * e2x;
+        double const f = 1.0 / (e1x * px + e1y * py + e1z * pz);
+        double const sx = ox - triangle[0].x, sy = oy - triangle[0].y, sz = oz - triangle[0].z;
+        double const u = f * (sx * px + sy * py + sz * pz);
+        double const qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+        double const v = f * (dx * qx + dy * qy + dz * qz);
+        double const t = f * (e2x * qx + e2y * qy + e2z * qz);
+
+        double const tolerance = 1e-4;
+        return std::fabs(u) < tolerance || std::fabs(u - 1.0) < tolerance || std::fabs(v) < tolerance ||
+            std::fabs(u + v - 1.0) < tolerance || std::fabs(t) < tolerance || std::fabs(t - distance) < tolerance * distance;
+    }
+}
+
+TEST(TriangleBlockTest, HitsTriangleInFront)
+{
+    TriangleBlock block;
+    block.Set(0, G3D::Vector3(-1.0f, -1.0f, 5.0f), G3D::Vector3(1.0f, -1.0f, 5.0f), G3D::Vector3(0.0f, 1.0f, 5.0f));
+
+    float distance = 100.0f;
+    EXPECT_TRUE(block.IntersectRay(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, 1.0f)), distance));
+    EXPECT_FLOAT_EQ(distance, 5.0f);
+
+    // behind the origin
+    distance = 100.0f;
+    EXPECT_FALSE(block.IntersectRay(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, -1.0f)), distance));
+    EXPECT_FLOAT_EQ(distance, 100.0f);
+
+    // farther than the current hit
+    distance = 4.0f;
+    EXPECT_FALSE(block.IntersectRay(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, 1.0f)), distance));
+    EXPECT_FLOAT_EQ(distance, 4.0f);
+}
+
+TEST(TriangleBlockTest, ReturnsClosestLane)
+{
+    TriangleBlock block;
+    for (uint32 lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+    {
+        float z = 8.0f - float(lane);
+        block.Set(lane, G3D::Vector3(-1.0f, -1.0f, z), G3D::Vector3(1.0f, -1.0f, z), G3D::Vector3(0.0f, 1.0f, z));
+    }
+
+    float distance = 100.0f;
+    EXPECT_TRUE(block.IntersectRay(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, 1.0f)), distance));
+    EXPECT_FLOAT_EQ(distance, 5.0f);
+}
+
+TEST(TriangleBlockTest, UnusedLanesNeverHit)
+{
+    TriangleBlock block;
+
+    float distance = 100.0f;
+    EXPECT_FALSE(block.IntersectRay(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, 1.0f)), distance));
+    EXPECT_FALSE(block.IntersectRayScalar(G3D::Ray::fromOriginAndDirection(G3D::Vector3::zero(), G3D::Vector3(0.0f, 0.0f, 1.0f)), distance));
+}
+
+TEST(TriangleBlockTest, MatchesScalarOnRandomRays)
+{
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<uint32> lanes(1, TRIANGLE_BLOCK_SIZE);
+    std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+
+    uint32 hits = 0;
+    for (uint32 i = 0; i < 20000; ++i)
+    {
+        G3D::Vector3 triangles[TRIANGLE_BLOCK_SIZE][3];
+        uint32 usedLanes = lanes(rng);
+        for (uint32 lane = 0; lane < usedLanes; ++lane)
+        {
+            triangles[lane][0] = RandomPoint(rng, 50.0f);
+            triangles[lane][1] = triangles[lane][0] + RandomPoint(rng, 10.0f);
+            triangles[lane][2] = triangles[lane][0] + RandomPoint(rng, 10.0f);
+        }
+
+        // aim every other ray at a point inside one of the triangles
+        G3D::Vector3 const* aimed = triangles[usedLanes - 1];
+        float u = weight(rng);
+        float v = weight(rng) * (1.0f - u);
+        G3D::Vector3 target = aimed[0] + (aimed[1] - aimed[0]) * u + (aimed[2] - aimed[0]) * v;
+
+        G3D::Vector3 origin = RandomPoint(rng, 100.0f);
+        G3D::Vector3 direction = (i % 2) ? (target - origin).direction() : RandomPoint(rng, 1.0f).direction();
+        G3D::Ray ray = G3D::Ray::fromOriginAndDirection(origin, direction);
+
+        // slivers and grazing rays are ill-conditioned, rounding alone can move their hits
+        TriangleBlock block;
+        bool conditioned = true;
+        for (uint32 lane = 0; lane < usedLanes; ++lane)
+        {
+            G3D::Vector3 const normal = (triangles[lane][1] - triangles[lane][0]).cross(triangles[lane][2] - triangles[lane][0]);
+            conditioned = conditioned && normal.length() > 1.0f && std::fabs(normal.direction().dot(direction)) > 0.1f;
+            block.Set(lane, triangles[lane][0], triangles[lane][1], triangles[lane][2]);
+        }
+
+        if (!conditioned)
+            continue;
+
+        float maxDistance = (i % 3) ? 1000.0f : 50.0f;
+        float distance = maxDistance;
+        float scalarDistance = maxDistance;
+        bool hit = block.IntersectRay(ray, distance);
+        bool scalarHit = block.IntersectRayScalar(ray, scalarDistance);
+
+        // compilers may fuse the scalar multiply-adds, which can flip hits right on an edge
+        if (hit != scalarHit)
+        {
+            bool borderline = false;
+            for (uint32 lane = 0; lane < usedLanes; ++lane)
+                borderline = borderline || IsBorderline(triangles[lane], ray, maxDistance);
+
+            ASSERT_TRUE(borderline) << "ray " << i;
+            continue;
+        }
+
+        ASSERT_NEAR(distance, scalarDistance, scalarDistance * 1e-4f) << "ray " << i;
+        hits += hit;
+    }
+
+    // make sure both outcomes were exercised
+    EXPECT_GT(hits, 2000u);
+    EXPECT_LT(hits, 15000u);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "TaskGraph.h"
+#include "gtest/gtest.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace Acore;
+
+namespace
+{
+    std::size_t IndexOf(std::vector<std::string> const& order, std::string const& name)
+    {
+        for (std::size_t i = 0; i < order.size(); ++i)
+            if (order[i] == name)
+                return i;
+
+        return order.size();
+    }
+}
+
+TEST(TaskGraphTest, SingleThreadRunsInDeclarationOrder)
+{
+    TaskGraph graph;
+    std::vector<std::string> order;
+
+    graph.Add("a", [&order]() { order.push_back("a"); });
+    graph.Add("b", [&order]() { order.push_back("b"); });
+    graph.Add("c", [&order]() { order.push_back("c"); }, { "a" });
+    graph.Add("d", [&order]() { order.push_back("d"); }, { "b", "c" });
+
+    graph.Run(1);
+
+    EXPECT_EQ(order, std::vector<std::string>({ "a", "b", "c", "d" }));
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(TaskGraphTest, DependenciesFinishFirst)
+{
+    for (uint32 threads : { 2, 4, 8 })
+    {
+        TaskGraph graph;
+        std::mutex lock;
+        std::vector<std::string> order;
+
+        auto task = [&lock, &order](std::string const& name)
+        {
+            return [&lock, &order, name]()
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                order.push_back(name);
+            };
+        };
+
+        graph.Add("templates", task("templates"));
+        graph.Add("addons", task("addons"), { "templates" });
+        graph.Add("texts", task("texts"));
+        graph.Add("spawns", task("spawns"), { "templates", "texts" });
+        graph.Add("spawn addons", task("spawn addons"), { "spawns", "addons" });
+        for (uint32 i = 0; i < 16; ++i)
+            graph.Add("independent " + std::to_string(i), task("independent " + std::to_string(i)));
+
+        graph.Run(threads);
+
+        ASSERT_EQ(order.size(), 21u);
+        EXPECT_LT(IndexOf(order, "templates"), IndexOf(order, "addons"));
+        EXPECT_LT(IndexOf(order, "templates"), IndexOf(order, "spawns"));
+        EXPECT_LT(IndexOf(order, "texts"), IndexOf(order, "spawns"));
+        EXPECT_LT(IndexOf(order, "spawns"), IndexOf(order, "spawn addons"));
+        EXPECT_LT(IndexOf(order, "addons"), IndexOf(order, "spawn addons"));
+        EXPECT_TRUE(graph.empty());
+    }
+}
+
+TEST(TaskGraphTest, EmptyGraph)
+{
+    TaskGraph graph;
+    graph.Run(4);
+    EXPECT_TRUE(graph.empty());
+}
+
+// assertions are compiled out in profiling builds
+#ifndef PERFORMANCE_PROFILING
+TEST(TaskGraphTest, UndeclaredDependencyAsserts)
+{
+    TaskGraph graph;
+    graph.Add("a", []() { });
+
+    EXPECT_DEATH(graph.Add("b", []() { }, { "c" }), "");
+}
+#endif
@@ -644,6 +644,11 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
             map.heightMapSize += sizeof(V9) + sizeof(V8);
     }
 
+    // uint8 heights have an odd size, pad the section so the liquid data stays aligned
+    // and the worldserver can use the arrays of a memory mapped file in place
+    uint32 heightMapPadding = (4 - map.heightMapSize % 4) % 4;
+    map.heightMapSize += heightMapPadding;
+
     // Get from MCLQ chunk (old)
     for (int i = 0; i < ADT_CELLS_PER_GRID; i++)
     {
@@ -934,6 +939,12 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
         fwrite(flight_box_min, sizeof(flight_box_min), 1, output);
     }
 
+    if (heightMapPadding)
+    {
+        uint8 const padding[4] = { };
+        fwrite(padding, heightMapPadding, 1, output);
+    }
+
     // Store liquid data if need
     if (map.liquidMapOffset)
     {